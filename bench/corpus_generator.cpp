@@ -0,0 +1,202 @@
+/**
+ * SPDX-FileComment: Synthetic photo corpus for the import benchmark implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file corpus_generator.cpp
+ * @brief Generates a deterministic tree of JPEG/PNG files with metadata
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "corpus_generator.hpp"
+#include <Magick++.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <exiv2/exiv2.hpp>
+#include <format>
+#include <fstream>
+#include <random>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace bench {
+
+namespace {
+
+struct Place {
+  const char *continent;
+  const char *country;
+  const char *province;
+  const char *city;
+  double lat;
+  double lon;
+};
+
+constexpr std::array<Place, 8> kPlaces = {{
+    {"Europe", "Germany", "Bavaria", "Munich", 48.137, 11.575},
+    {"Europe", "Germany", "Berlin", "Berlin", 52.520, 13.405},
+    {"Europe", "France", "Ile-de-France", "Paris", 48.857, 2.352},
+    {"Europe", "Italy", "Lazio", "Rome", 41.903, 12.496},
+    {"Asia", "Japan", "Kanto", "Tokyo", 35.676, 139.650},
+    {"Asia", "China", "Shanghai", "Shanghai", 31.230, 121.474},
+    {"North America", "USA", "California", "San Francisco", 37.775,
+     -122.419},
+    {"South America", "Chile", "Santiago", "Santiago", -33.449, -70.669},
+}};
+
+constexpr std::array<std::pair<int, int>, 5> kResolutions = {{
+    {1600, 1200}, {2048, 1536}, {3000, 2000}, {4032, 3024}, {6000, 4000}}};
+
+/// "48/1 8/1 1332/100" for use as an EXIF GPS rational triple.
+std::string to_dms(double degrees) {
+  degrees = std::fabs(degrees);
+  const int d = static_cast<int>(degrees);
+  const double m_full = (degrees - d) * 60.0;
+  const int m = static_cast<int>(m_full);
+  const int s_hundredths =
+      static_cast<int>(std::lround((m_full - m) * 60.0 * 100.0));
+  return std::format("{}/1 {}/1 {}/100", d, m, s_hundredths);
+}
+
+/**
+ * @brief Gradient plus low-amplitude noise; compresses like a real photo
+ * rather than a flat fill, and only depends on the seed.
+ */
+std::vector<std::uint8_t> render_pixels(int width, int height,
+                                        std::uint32_t seed) {
+  std::vector<std::uint8_t> rgb(static_cast<std::size_t>(width) *
+                                static_cast<std::size_t>(height) * 3);
+  std::uint32_t state = seed | 1u;
+  std::size_t i = 0;
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      state ^= state << 13;
+      state ^= state >> 17;
+      state ^= state << 5;
+      const int noise = static_cast<int>(state & 31) - 16;
+      const int r = x * 255 / width + noise;
+      const int g = y * 255 / height + noise;
+      const int b = (x + y) * 255 / (width + height) - noise;
+      rgb[i++] = static_cast<std::uint8_t>(std::clamp(r, 0, 255));
+      rgb[i++] = static_cast<std::uint8_t>(std::clamp(g, 0, 255));
+      rgb[i++] = static_cast<std::uint8_t>(std::clamp(b, 0, 255));
+    }
+  }
+  return rgb;
+}
+
+void write_metadata(const fs::path &path, const Place &place,
+                    const std::string &exif_date, int orientation) {
+  auto image = Exiv2::ImageFactory::open(path.string());
+  image->readMetadata();
+
+  auto &exif = image->exifData();
+  exif["Exif.Image.Make"] = std::string("BenchCam");
+  exif["Exif.Image.Model"] = std::string("Synthetic 1");
+  exif["Exif.Image.Orientation"] = static_cast<std::uint16_t>(orientation);
+  exif["Exif.Image.DateTime"] = exif_date;
+  exif["Exif.Photo.DateTimeOriginal"] = exif_date;
+  exif["Exif.GPSInfo.GPSLatitudeRef"] = std::string(place.lat < 0 ? "S" : "N");
+  exif["Exif.GPSInfo.GPSLatitude"] = to_dms(place.lat);
+  exif["Exif.GPSInfo.GPSLongitudeRef"] =
+      std::string(place.lon < 0 ? "W" : "E");
+  exif["Exif.GPSInfo.GPSLongitude"] = to_dms(place.lon);
+
+  Exiv2::Iptcdatum keyword(Exiv2::IptcKey("Iptc.Application2.Keywords"));
+  keyword.setValue(place.city);
+  image->iptcData().add(keyword);
+
+  image->xmpData()["Xmp.dc.subject"] = std::string(place.country);
+  image->writeMetadata();
+}
+
+std::string marker_text(const CorpusSpec &spec) {
+  return std::format("count={} seed={} version=1\n", spec.count, spec.seed);
+}
+
+} // namespace
+
+std::expected<std::size_t, std::string>
+generate_corpus(const CorpusSpec &spec) {
+  const auto marker = spec.root / ".bench-corpus";
+  {
+    std::ifstream in(marker);
+    std::string existing((std::istreambuf_iterator<char>(in)),
+                         std::istreambuf_iterator<char>());
+    if (existing == marker_text(spec))
+      return 0;
+  }
+
+  std::error_code ec;
+  fs::remove_all(spec.root, ec);
+  fs::create_directories(spec.root, ec);
+  if (ec)
+    return std::unexpected(
+        std::format("Could not create {}: {}", spec.root.string(), ec.message()));
+
+  std::mt19937 rng(spec.seed);
+  for (std::size_t n = 0; n < spec.count; ++n) {
+    const auto &place = kPlaces[rng() % kPlaces.size()];
+    auto [width, height] = kResolutions[rng() % kResolutions.size()];
+    const bool portrait = rng() % 4 == 0;
+    if (portrait)
+      std::swap(width, height);
+    const bool png = rng() % 100 < 15;
+    const bool dated_folder = rng() % 2 == 0;
+
+    const int month = static_cast<int>(rng() % 12) + 1;
+    const int day = static_cast<int>(rng() % 28) + 1;
+    const int hour = static_cast<int>(rng() % 24);
+    const int minute = static_cast<int>(rng() % 60);
+    const int second = static_cast<int>(rng() % 60);
+    const int year = 2015 + static_cast<int>(rng() % 10);
+
+    fs::path dir = spec.root / place.continent / place.country /
+                   place.province / place.city;
+    if (dated_folder)
+      dir /= std::format("{:04}-{:02}-{:02}", year, month, day);
+    fs::create_directories(dir, ec);
+    if (ec)
+      return std::unexpected(ec.message());
+
+    const auto file =
+        dir / std::format("IMG_{:04}{:02}{:02}_{:02}{:02}{:02}_{:05}.{}", year,
+                          month, day, hour, minute, second, n,
+                          png ? "png" : "jpg");
+
+    try {
+      auto pixels = render_pixels(width, height, static_cast<std::uint32_t>(rng()));
+      Magick::Image image;
+      image.read(static_cast<std::size_t>(width),
+                 static_cast<std::size_t>(height), "RGB", Magick::CharPixel,
+                 pixels.data());
+      image.magick(png ? "PNG" : "JPEG");
+      if (!png)
+        image.quality(88);
+      image.write(file.string());
+
+      write_metadata(file, place,
+                     std::format("{:04}:{:02}:{:02} {:02}:{:02}:{:02}", year,
+                                 month, day, hour, minute, second),
+                     portrait ? 6 : 1);
+    } catch (const std::exception &e) {
+      return std::unexpected(
+          std::format("Could not generate {}: {}", file.string(), e.what()));
+    }
+  }
+
+  std::ofstream(marker) << marker_text(spec);
+  return spec.count;
+}
+
+} // namespace bench
@@ -0,0 +1,56 @@
+/**
+ * SPDX-FileComment: Synthetic photo corpus for the import benchmark
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file corpus_generator.hpp
+ * @brief Generates a deterministic tree of JPEG/PNG files with metadata
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <string>
+
+/**
+ * @namespace bench
+ * @brief Namespace for the benchmark harness.
+ */
+namespace bench {
+
+/**
+ * @struct CorpusSpec
+ * @brief Shape of the synthetic corpus. Same spec, same bytes.
+ */
+struct CorpusSpec {
+  std::filesystem::path root;
+  std::size_t count = 200;
+  std::uint32_t seed = 1;
+};
+
+/**
+ * @brief Creates the corpus below spec.root unless an identical one is
+ * already there.
+ *
+ * Files are laid out as Continent/Country/Province/City[/YYYY-MM-DD]/ like
+ * PathParser expects. About 85% are JPEGs, the rest PNGs, at resolutions
+ * from 1600x1200 to 6000x4000 in both orientations. Each file carries EXIF
+ * (camera, dates, orientation, GPS), an IPTC keyword and an XMP subject.
+ *
+ * @return Number of files generated (0 if the corpus was reused).
+ */
+std::expected<std::size_t, std::string> generate_corpus(const CorpusSpec &spec);
+
+} // namespace bench
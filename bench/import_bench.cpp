@@ -0,0 +1,395 @@
+/**
+ * SPDX-FileComment: Import pipeline benchmark
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file import_bench.cpp
+ * @brief Imports a synthetic corpus and reports throughput, CPU and memory
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "core/config/config_loader.hpp"
+#include "corpus_generator.hpp"
+#include "importer/directory_scanner.hpp"
+#include "importer/image_engine.hpp"
+#include "importer/import_metrics.hpp"
+#include "importer/import_pipeline.hpp"
+#include "importer/location_cache.hpp"
+#include "importer/photo_processor.hpp"
+#include "infra/repositories/photo_repository.hpp"
+#include "memory_repositories.hpp"
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <drogon/drogon.h>
+#include <fcntl.h>
+#include <filesystem>
+#include <format>
+#include <print>
+#include <string_view>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct BenchOptions {
+  bench::CorpusSpec corpus{"/tmp/gallery-bench/corpus", 200, 1};
+  fs::path thumb_root = "/tmp/gallery-bench/thumbs";
+  std::size_t jobs = 0;
+  bool postgres = false;
+  bool generate_only = false;
+  bool compare_engines = false;
+  importer::ProcessorOptions processor;
+};
+
+/// Numbers of one run; passed from the child to the parent with
+/// --compare-engines.
+struct BenchResult {
+  std::size_t imported = 0;
+  std::size_t failed = 0;
+  double wall = 0;
+  double cpu = 0;
+  long peak_rss_kib = 0;
+};
+
+void print_usage() {
+  std::println("Usage: gallery-import-bench [options]");
+  std::println("");
+  std::println("  --count N          Photos in the synthetic corpus "
+               "(default: 200)");
+  std::println("  --seed N           Corpus seed (default: 1)");
+  std::println("  --corpus DIR       Corpus directory (default: "
+               "/tmp/gallery-bench/corpus)");
+  std::println("  --thumbs DIR       Thumbnail output, wiped before each run");
+  std::println("                     (default: /tmp/gallery-bench/thumbs)");
+  std::println("  -j, --jobs N       Worker threads (default: one per core)");
+  std::println("  --postgres         Store into the database from "
+               "/app/.env instead of memory");
+  std::println("  --engine NAME      magick (default) or vips");
+  std::println("  --compare-engines  Run once per available engine and "
+               "compare them");
+  std::println("  --encoder NAME     libwebp (default) or magick");
+  std::println("  --metadata MODE    full (default) or fast");
+  std::println("  --generate-only    Create the corpus and exit");
+}
+
+std::optional<BenchOptions> parse_options(int argc, char **argv) {
+  BenchOptions opts;
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    auto next = [&]() -> std::optional<std::string_view> {
+      if (i + 1 >= argc)
+        return std::nullopt;
+      return std::string_view(argv[++i]);
+    };
+    auto number = [&]() -> std::optional<std::size_t> {
+      auto value = next();
+      std::size_t n = 0;
+      if (!value ||
+          std::from_chars(value->data(), value->data() + value->size(), n).ec !=
+              std::errc())
+        return std::nullopt;
+      return n;
+    };
+
+    if (arg == "--count") {
+      auto n = number();
+      if (!n)
+        return std::nullopt;
+      opts.corpus.count = *n;
+    } else if (arg == "--seed") {
+      auto n = number();
+      if (!n)
+        return std::nullopt;
+      opts.corpus.seed = static_cast<std::uint32_t>(*n);
+    } else if (arg == "--corpus") {
+      auto v = next();
+      if (!v)
+        return std::nullopt;
+      opts.corpus.root = *v;
+    } else if (arg == "--thumbs") {
+      auto v = next();
+      if (!v)
+        return std::nullopt;
+      opts.thumb_root = *v;
+    } else if (arg == "--jobs" || arg == "-j") {
+      auto n = number();
+      if (!n)
+        return std::nullopt;
+      opts.jobs = *n;
+    } else if (arg == "--postgres") {
+      opts.postgres = true;
+    } else if (arg == "--engine") {
+      auto v = next();
+      auto engine = v ? importer::parse_image_engine(*v) : std::nullopt;
+      if (!engine || !importer::image_engine_available(*engine))
+        return std::nullopt;
+      opts.processor.engine = *engine;
+    } else if (arg == "--compare-engines") {
+      opts.compare_engines = true;
+    } else if (arg == "--encoder") {
+      auto v = next();
+      auto backend = v ? importer::parse_encoder_backend(*v) : std::nullopt;
+      if (!backend)
+        return std::nullopt;
+      opts.processor.encoder = *backend;
+    } else if (arg == "--metadata") {
+      auto v = next();
+      if (!v || (*v != "full" && *v != "fast"))
+        return std::nullopt;
+      opts.processor.full_metadata = *v == "full";
+    } else if (arg == "--generate-only") {
+      opts.generate_only = true;
+    } else {
+      return std::nullopt;
+    }
+  }
+  // Each engine runs in its own process against the in-memory repositories.
+  if (opts.compare_engines && opts.postgres)
+    return std::nullopt;
+  opts.processor.thumb_root = opts.thumb_root;
+  return opts;
+}
+
+double cpu_seconds(const rusage &usage) {
+  auto seconds = [](const timeval &tv) {
+    return static_cast<double>(tv.tv_sec) +
+           static_cast<double>(tv.tv_usec) / 1e6;
+  };
+  return seconds(usage.ru_utime) + seconds(usage.ru_stime);
+}
+
+/**
+ * @brief Imports the corpus once and prints the report.
+ *
+ * @param result Receives the headline numbers if not null.
+ */
+int run_bench(const BenchOptions &opts,
+              domain::interfaces::IPhotoRepository &photos,
+              domain::interfaces::ILocationRepository &location_repo,
+              BenchResult *result = nullptr) {
+  std::error_code ec;
+  fs::remove_all(opts.thumb_root, ec);
+
+  rusage before{};
+  getrusage(RUSAGE_SELF, &before);
+  const auto started = std::chrono::steady_clock::now();
+
+  importer::LocationCache locations(location_repo);
+  if (auto res = locations.preload(); !res) {
+    std::println(stderr, "Could not load locations: {}", res.error());
+    return 1;
+  }
+
+  importer::ImportMetrics metrics;
+  importer::PhotoProcessor processor(photos, locations, opts.processor,
+                                     nullptr, &metrics);
+  importer::PipelineOptions pipeline_options;
+  pipeline_options.jobs = opts.jobs;
+  pipeline_options.log_each_file = false;
+
+  std::size_t imported = 0;
+  std::size_t failed = 0;
+  std::size_t bytes_read = 0;
+  {
+    importer::ImportPipeline pipeline(processor, pipeline_options);
+    auto scanned = importer::scan_tree(
+        opts.corpus.root, [&](std::string &&path) {
+          pipeline.submit(opts.corpus.root, path);
+        });
+    if (!scanned)
+      std::println(stderr, "Error: {}", scanned.error());
+    pipeline.finish();
+    imported = pipeline.stats().imported.load();
+    failed = pipeline.stats().failed.load();
+    bytes_read = pipeline.stats().bytes_read.load();
+  }
+
+  const double wall = std::chrono::duration<double>(
+                          std::chrono::steady_clock::now() - started)
+                          .count();
+  rusage after{};
+  getrusage(RUSAGE_SELF, &after);
+  const double cpu = cpu_seconds(after) - cpu_seconds(before);
+  const auto photos_done = std::max<std::size_t>(imported, 1);
+
+  std::println("--------------------------------------------------");
+  std::println("photos imported   {}", imported);
+  std::println("photos failed     {}", failed);
+  std::println("wall time         {:.2f} s", wall);
+  std::println("throughput        {:.2f} photos/s",
+               static_cast<double>(imported) / wall);
+  std::println("cpu per photo     {:.3f} s",
+               cpu / static_cast<double>(photos_done));
+  std::println("read per photo    {} KiB", bytes_read / photos_done >> 10);
+  // ru_maxrss is in KiB on Linux and covers the whole process lifetime.
+  std::println("peak rss          {} MiB", after.ru_maxrss >> 10);
+  std::println("");
+  metrics.print_summary(stdout);
+
+  if (result)
+    *result = {imported, failed, wall, cpu, after.ru_maxrss};
+  return failed == 0 ? 0 : 2;
+}
+
+/**
+ * @brief Runs the benchmark once per engine built in and prints a table.
+ *
+ * Every engine gets a fresh child process, so peak RSS and the
+ * allocator's state of one run do not leak into the next. Thumbnails go
+ * to a subdirectory per engine for comparing the output.
+ */
+int compare_engines(const BenchOptions &opts) {
+  struct Row {
+    importer::ImageEngineKind engine;
+    BenchResult result;
+    bool ok = false;
+  };
+  std::vector<Row> rows;
+  int rc = 0;
+
+  for (auto engine :
+       {importer::ImageEngineKind::Magick, importer::ImageEngineKind::Vips}) {
+    if (!importer::image_engine_available(engine))
+      continue;
+    const auto name = importer::image_engine_name(engine);
+    std::println("");
+    std::println("== engine: {} ==", name);
+    std::fflush(stdout);
+
+    int fds[2];
+    if (pipe(fds) != 0) {
+      std::println(stderr, "pipe: {}", std::strerror(errno));
+      return 1;
+    }
+    const pid_t pid = fork();
+    if (pid < 0) {
+      std::println(stderr, "fork: {}", std::strerror(errno));
+      return 1;
+    }
+    if (pid == 0) {
+      close(fds[0]);
+      // The child inherits the parent's RSS high-water mark (e.g. from
+      // generating the corpus); "5" resets it to the current RSS.
+      if (int fd = open("/proc/self/clear_refs", O_WRONLY); fd >= 0) {
+        [[maybe_unused]] auto written = write(fd, "5", 1);
+        close(fd);
+      }
+      BenchOptions child = opts;
+      child.processor.engine = engine;
+      child.thumb_root = opts.thumb_root / name;
+      child.processor.thumb_root = child.thumb_root;
+      BenchResult result;
+      bench::InMemoryPhotoRepository photos;
+      bench::InMemoryLocationRepository locations;
+      const int child_rc = run_bench(child, photos, locations, &result);
+      [[maybe_unused]] auto written = write(fds[1], &result, sizeof result);
+      std::fflush(stdout);
+      _exit(child_rc);
+    }
+
+    close(fds[1]);
+    Row row{engine, {}};
+    row.ok = read(fds[0], &row.result, sizeof row.result) ==
+             static_cast<ssize_t>(sizeof row.result);
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+      rc = 2;
+    rows.push_back(row);
+  }
+
+  std::println("");
+  std::println("{:<8} {:>10} {:>12} {:>12} {:>8}", "engine", "photos/s",
+               "cpu/photo s", "peak rss MiB", "failed");
+  for (const auto &row : rows) {
+    const auto name = importer::image_engine_name(row.engine);
+    if (!row.ok) {
+      std::println("{:<8} {:>10}", name, "crashed");
+      continue;
+    }
+    const auto &r = row.result;
+    const auto done = static_cast<double>(std::max<std::size_t>(r.imported, 1));
+    std::println("{:<8} {:>10.2f} {:>12.3f} {:>12} {:>8}", name,
+                 static_cast<double>(r.imported) / r.wall, r.cpu / done,
+                 r.peak_rss_kib >> 10, r.failed);
+  }
+  return rc;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  auto opts = parse_options(argc, argv);
+  if (!opts) {
+    print_usage();
+    return 1;
+  }
+
+  importer::PhotoProcessor::init_codecs(*argv);
+
+  std::println("Preparing corpus in {} ({} photos, seed {})...",
+               opts->corpus.root.string(), opts->corpus.count,
+               opts->corpus.seed);
+  auto generated = bench::generate_corpus(opts->corpus);
+  if (!generated) {
+    std::println(stderr, "{}", generated.error());
+    return 1;
+  }
+  std::println("{}", *generated == 0 ? "Reusing existing corpus."
+                                     : "Corpus generated.");
+  if (opts->generate_only)
+    return 0;
+
+  if (opts->compare_engines)
+    return compare_engines(*opts);
+
+  if (!opts->postgres) {
+    bench::InMemoryPhotoRepository photos;
+    bench::InMemoryLocationRepository locations;
+    return run_bench(*opts, photos, locations);
+  }
+
+  using core::config::ConfigLoader;
+  ConfigLoader::load("/app/.env");
+  Json::Value config;
+  Json::Value db_client;
+  db_client["name"] = "default";
+  db_client["rdbms"] = "postgresql";
+  db_client["host"] = ConfigLoader::get("DB_HOST", "psql_db");
+  db_client["port"] = std::stoi(ConfigLoader::get("DB_PORT", "5432"));
+  db_client["dbname"] = ConfigLoader::get("DB_NAME", "gallery");
+  db_client["user"] = ConfigLoader::get("DB_USER", "gallery_user");
+  db_client["passwd"] = ConfigLoader::get("DB_PASSWORD", "");
+  db_client["connection_number"] = 2;
+  config["db_clients"].append(db_client);
+  drogon::app().loadConfigJson(config);
+
+  int rc = 0;
+  std::thread worker([&] {
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    infra::repositories::PostgresPhotoRepository photos;
+    infra::repositories::PostgresLocationRepository locations;
+    rc = run_bench(*opts, photos, locations);
+    drogon::app().quit();
+  });
+  drogon::app().run();
+  worker.join();
+  return rc;
+}
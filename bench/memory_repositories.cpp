@@ -0,0 +1,201 @@
+/**
+ * SPDX-FileComment: In-memory repository stand-ins for the benchmark implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file memory_repositories.cpp
+ * @brief Photo and location repositories backed by hash maps
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "memory_repositories.hpp"
+#include <algorithm>
+#include <map>
+
+namespace bench {
+
+std::expected<std::vector<Photo>, std::string>
+InMemoryPhotoRepository::find_all(
+    const domain::interfaces::PhotoFilter &filter) {
+  std::lock_guard lock(mutex_);
+  std::vector<Photo> out;
+  for (const auto &[path, photo] : by_path_) {
+    if (filter.location_id && photo.location_id != filter.location_id)
+      continue;
+    out.push_back(photo);
+  }
+  return out;
+}
+
+std::expected<std::optional<Photo>, std::string>
+InMemoryPhotoRepository::find_by_id(std::string_view id) {
+  std::lock_guard lock(mutex_);
+  for (const auto &[path, photo] : by_path_) {
+    if (photo.id == id)
+      return photo;
+  }
+  return std::nullopt;
+}
+
+std::string InMemoryPhotoRepository::save_locked(const Photo &photo) {
+  auto [it, inserted] = by_path_.try_emplace(photo.file_path, photo);
+  if (!inserted) {
+    // Same as ON CONFLICT (file_path): keep the existing id.
+    auto id = it->second.id;
+    it->second = photo;
+    it->second.id = id;
+  }
+  return it->second.id;
+}
+
+std::expected<std::string, std::string>
+InMemoryPhotoRepository::save(const Photo &photo) {
+  std::lock_guard lock(mutex_);
+  return save_locked(photo);
+}
+
+std::expected<std::vector<std::string>, std::string>
+InMemoryPhotoRepository::save_batch(const std::vector<Photo> &photos) {
+  std::lock_guard lock(mutex_);
+  std::vector<std::string> ids;
+  ids.reserve(photos.size());
+  for (const auto &photo : photos)
+    ids.push_back(save_locked(photo));
+  return ids;
+}
+
+std::expected<void, std::string>
+InMemoryPhotoRepository::replace_metadata_batch(
+    const std::vector<Photo> &photos) {
+  std::lock_guard lock(mutex_);
+  for (const auto &photo : photos) {
+    if (!by_path_.contains(photo.file_path))
+      return std::unexpected("No photo stored for " + photo.file_path);
+  }
+  for (const auto &photo : photos) {
+    auto &stored = by_path_[photo.file_path];
+    stored.exif = photo.exif;
+    stored.iptc = photo.iptc;
+    stored.xmp = photo.xmp;
+    stored.tags = photo.tags;
+  }
+  return {};
+}
+
+std::expected<std::optional<Photo>, std::string>
+InMemoryPhotoRepository::find_by_content_hash(std::string_view content_hash) {
+  std::lock_guard lock(mutex_);
+  for (const auto &[path, photo] : by_path_) {
+    if (photo.content_hash == content_hash)
+      return photo;
+  }
+  return std::nullopt;
+}
+
+std::expected<std::vector<DuplicateGroup>, std::string>
+InMemoryPhotoRepository::find_duplicates() {
+  std::lock_guard lock(mutex_);
+  std::map<std::string, std::vector<std::string>> groups;
+  for (const auto &[path, photo] : by_path_) {
+    if (photo.content_hash)
+      groups[*photo.content_hash].push_back(path);
+  }
+  std::vector<DuplicateGroup> out;
+  for (auto &[hash, paths] : groups) {
+    if (paths.size() < 2)
+      continue;
+    std::ranges::sort(paths);
+    out.push_back({hash, std::move(paths)});
+  }
+  return out;
+}
+
+std::expected<std::size_t, std::string>
+InMemoryPhotoRepository::remove_by_path(std::string_view path) {
+  const auto prefix = std::string(path) + "/";
+  std::lock_guard lock(mutex_);
+  return std::erase_if(by_path_, [&](const auto &item) {
+    return item.first == path || item.first.starts_with(prefix);
+  });
+}
+
+std::expected<std::vector<PhotoPaths>, std::string>
+InMemoryPhotoRepository::list_paths() {
+  std::lock_guard lock(mutex_);
+  std::vector<PhotoPaths> paths;
+  paths.reserve(by_path_.size());
+  for (const auto &[path, photo] : by_path_)
+    paths.push_back({path, photo.thumb_path});
+  return paths;
+}
+
+std::expected<std::size_t, std::string>
+InMemoryPhotoRepository::remove_paths(
+    const std::vector<std::string> &file_paths) {
+  std::lock_guard lock(mutex_);
+  std::size_t removed = 0;
+  for (const auto &path : file_paths)
+    removed += by_path_.erase(path);
+  return removed;
+}
+
+std::expected<void, std::string>
+InMemoryPhotoRepository::add_tag(std::string_view, std::string_view) {
+  return {};
+}
+
+std::expected<void, std::string> InMemoryPhotoRepository::save_metadata_exif(
+    std::string_view, const std::map<std::string, std::string> &) {
+  return {};
+}
+
+std::expected<void, std::string> InMemoryPhotoRepository::save_metadata_iptc(
+    std::string_view, const std::map<std::string, std::string> &) {
+  return {};
+}
+
+std::expected<void, std::string> InMemoryPhotoRepository::save_metadata_xmp(
+    std::string_view, const std::map<std::string, std::string> &) {
+  return {};
+}
+
+std::size_t InMemoryPhotoRepository::size() const {
+  std::lock_guard lock(mutex_);
+  return by_path_.size();
+}
+
+std::expected<std::vector<Location>, std::string>
+InMemoryLocationRepository::get_tree(bool) {
+  return find_all();
+}
+
+std::expected<std::vector<Location>, std::string>
+InMemoryLocationRepository::find_all() {
+  std::lock_guard lock(mutex_);
+  return locations_;
+}
+
+std::expected<std::optional<Location>, std::string>
+InMemoryLocationRepository::find_or_create(const Location &loc) {
+  std::lock_guard lock(mutex_);
+  auto it = std::ranges::find_if(locations_, [&](const Location &l) {
+    return l.continent == loc.continent && l.country == loc.country &&
+           l.province == loc.province && l.city == loc.city;
+  });
+  if (it != locations_.end())
+    return *it;
+  Location created = loc;
+  created.id = std::to_string(locations_.size() + 1);
+  locations_.push_back(created);
+  return created;
+}
+
+} // namespace bench
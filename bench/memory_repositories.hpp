@@ -0,0 +1,94 @@
+/**
+ * SPDX-FileComment: In-memory repository stand-ins for the benchmark
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file memory_repositories.hpp
+ * @brief Photo and location repositories backed by hash maps
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include "domain/interfaces/i_photo_repository.hpp"
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace bench {
+
+using namespace domain::models;
+
+/**
+ * @class InMemoryPhotoRepository
+ * @brief Keeps photos keyed by file_path, mirroring the upsert semantics of
+ * the Postgres repository, so the benchmark measures the importer alone.
+ */
+class InMemoryPhotoRepository : public domain::interfaces::IPhotoRepository {
+public:
+  std::expected<std::vector<Photo>, std::string>
+  find_all(const domain::interfaces::PhotoFilter &filter) override;
+  std::expected<std::optional<Photo>, std::string>
+  find_by_id(std::string_view id) override;
+  std::expected<std::string, std::string> save(const Photo &photo) override;
+  std::expected<std::vector<std::string>, std::string>
+  save_batch(const std::vector<Photo> &photos) override;
+  std::expected<void, std::string>
+  replace_metadata_batch(const std::vector<Photo> &photos) override;
+  std::expected<std::optional<Photo>, std::string>
+  find_by_content_hash(std::string_view content_hash) override;
+  std::expected<std::vector<DuplicateGroup>, std::string>
+  find_duplicates() override;
+  std::expected<std::size_t, std::string>
+  remove_by_path(std::string_view path) override;
+  std::expected<std::vector<PhotoPaths>, std::string> list_paths() override;
+  std::expected<std::size_t, std::string>
+  remove_paths(const std::vector<std::string> &file_paths) override;
+  std::expected<void, std::string> add_tag(std::string_view photo_id,
+                                           std::string_view tag) override;
+  std::expected<void, std::string>
+  save_metadata_exif(std::string_view photo_id,
+                     const std::map<std::string, std::string> &metadata) override;
+  std::expected<void, std::string>
+  save_metadata_iptc(std::string_view photo_id,
+                     const std::map<std::string, std::string> &metadata) override;
+  std::expected<void, std::string>
+  save_metadata_xmp(std::string_view photo_id,
+                    const std::map<std::string, std::string> &metadata) override;
+
+  std::size_t size() const;
+
+private:
+  std::string save_locked(const Photo &photo);
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Photo> by_path_;
+};
+
+/**
+ * @class InMemoryLocationRepository
+ * @brief Location table stand-in; ids are sequential strings.
+ */
+class InMemoryLocationRepository
+    : public domain::interfaces::ILocationRepository {
+public:
+  std::expected<std::vector<Location>, std::string>
+  get_tree(bool only_public = false) override;
+  std::expected<std::vector<Location>, std::string> find_all() override;
+  std::expected<std::optional<Location>, std::string>
+  find_or_create(const Location &loc) override;
+
+private:
+  std::mutex mutex_;
+  std::vector<Location> locations_;
+};
+
+} // namespace bench
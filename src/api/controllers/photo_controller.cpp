@@ -64,6 +64,9 @@ void PhotoController::get_photos(
                  {"thumb_path", p.thumb_path.value_or("")},
                  {"width", p.width.value_or(0)},
                  {"height", p.height.value_or(0)},
+                 {"blurhash", p.blurhash ? nlohmann::json(*p.blurhash) : nullptr},
+                 {"dominant_color",
+                  p.dominant_color ? nlohmann::json(*p.dominant_color) : nullptr},
                  {"is_public", p.is_public}});
   }
 
@@ -0,0 +1,72 @@
+/**
+ * SPDX-FileComment: Thumbnail Controller Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file thumbnail_controller.cpp
+ * @brief Thumbnail Controller Implementation file
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "thumbnail_controller.hpp"
+#include "core/config/config_loader.hpp"
+#include "infra/repositories/thumbnail_pack_repository.hpp"
+#include <drogon/HttpResponse.h>
+#include <filesystem>
+#include <nlohmann/json.hpp>
+
+namespace fs = std::filesystem;
+
+namespace api::controllers {
+
+void ThumbnailController::get_thumbnail(
+    const drogon::HttpRequestPtr & /*req*/,
+    std::function<void(const drogon::HttpResponsePtr &)> &&callback,
+    int size, std::string thumb_path) {
+  // The path comes from the URL; it must not leave the thumbnail root.
+  auto relative = fs::path(thumb_path).lexically_normal();
+  if (relative.empty() || relative.is_absolute() ||
+      *relative.begin() == "..") {
+    auto resp = drogon::HttpResponse::newHttpResponse();
+    resp->setStatusCode(drogon::HttpStatusCode::k404NotFound);
+    callback(resp);
+    return;
+  }
+
+  infra::repositories::PostgresThumbnailPackRepository repo;
+  auto packed = repo.find(relative.string(), size);
+  if (!packed) {
+    nlohmann::json error_json = {{"error", packed.error()}};
+    auto resp = drogon::HttpResponse::newHttpResponse();
+    resp->setBody(error_json.dump());
+    resp->setContentTypeCode(drogon::CT_APPLICATION_JSON);
+    resp->setStatusCode(drogon::HttpStatusCode::k500InternalServerError);
+    callback(resp);
+    return;
+  }
+
+  const fs::path root =
+      core::config::ConfigLoader::get("THUMB_ROOT", "/data/thumbs");
+  drogon::HttpResponsePtr resp;
+  if (*packed) {
+    const auto &t = **packed;
+    resp = drogon::HttpResponse::newFileResponse(
+        (root / t.pack).string(), static_cast<std::size_t>(t.offset),
+        static_cast<std::size_t>(t.length), false, "", drogon::CT_IMAGE_WEBP);
+  } else {
+    resp = drogon::HttpResponse::newFileResponse(
+        (root / std::to_string(size) / relative).string(), "",
+        drogon::CT_IMAGE_WEBP);
+  }
+  callback(resp);
+}
+
+} // namespace api::controllers
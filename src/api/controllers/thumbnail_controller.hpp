@@ -0,0 +1,58 @@
+/**
+ * SPDX-FileComment: Thumbnail Controller Header
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file thumbnail_controller.hpp
+ * @brief Thumbnail Controller Header file
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include <drogon/HttpController.h>
+
+/**
+ * @namespace api::controllers
+ * @brief Namespace for API controllers.
+ */
+namespace api::controllers {
+
+/**
+ * @class ThumbnailController
+ * @brief Serves thumbnails from pack files or the size directories.
+ */
+class ThumbnailController
+    : public drogon::HttpController<ThumbnailController> {
+public:
+  METHOD_LIST_BEGIN
+  ADD_METHOD_VIA_REGEX(ThumbnailController::get_thumbnail,
+                       "/api/thumbs/([0-9]+)/(.+)", drogon::Get);
+  METHOD_LIST_END
+
+  /**
+   * @brief Sends one thumbnail with sendfile.
+   *
+   * A thumbnail indexed in thumbnail_packs is sent as its byte range of
+   * the pack; otherwise <THUMB_ROOT>/<size>/<thumb_path> is sent.
+   *
+   * @param req The HTTP request.
+   * @param callback The response callback.
+   * @param size Thumbnail box size.
+   * @param thumb_path The photo's thumb_path.
+   */
+  void get_thumbnail(
+      const drogon::HttpRequestPtr &req,
+      std::function<void(const drogon::HttpResponsePtr &)> &&callback,
+      int size, std::string thumb_path);
+};
+
+} // namespace api::controllers
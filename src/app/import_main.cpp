@@ -6,8 +6,8 @@
  *
  * @file import_main.cpp
  * @brief Import CLI tool for processing and indexing photos
- * @version 0.1.4
- * @date 2026-02-25
+ * @version 0.2.0
+ * @date 2026-10-17
  *
  * @author ZHENG Robert (robert@hase-zheng.net)
  * @copyright Copyright (c) 2026 ZHENG Robert
@@ -16,284 +16,192 @@
  */
 
 #include "core/config/config_loader.hpp"
-#include "domain/models/photo_models.hpp"
-#include "infra/util/path_parser.hpp"
+#include "importer/archive_reader.hpp"
+#include "importer/directory_scanner.hpp"
+#include "importer/directory_watcher.hpp"
+#include "importer/import_metrics.hpp"
+#include "importer/import_manifest.hpp"
+#include "importer/import_options.hpp"
+#include "importer/import_pipeline.hpp"
+#include "importer/job_queue_worker.hpp"
+#include "importer/location_cache.hpp"
+#include "importer/photo_processor.hpp"
+#include "importer/progress_reporter.hpp"
+#include "importer/reconciler.hpp"
+#include "infra/repositories/import_job_repository.hpp"
+#include "infra/repositories/import_manifest_repository.hpp"
 #include "infra/repositories/photo_repository.hpp"
-#include <Magick++.h>
+#include "infra/repositories/thumbnail_pack_repository.hpp"
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
 #include <drogon/drogon.h>
-#include <exiv2/exiv2.hpp>
 #include <filesystem>
-#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <print>
+#include <stop_token>
+#include <string>
 #include <thread>
-#include <uuid/uuid.h>
-#include <iomanip>
-#include <sstream>
-#include <map>
-#include <regex>
+#include <vector>
 
 namespace fs = std::filesystem;
-using namespace domain::models;
 using namespace core::config;
 using namespace infra::repositories;
 
 /**
- * @brief Generates a universally unique identifier (UUID).
+ * @brief Prints groups of photos that share a content hash.
  */
-std::string generate_uuid() {
-  uuid_t b_uuid;
-  uuid_generate(b_uuid);
-  char out[37];
-  uuid_unparse_lower(b_uuid, out);
-  return std::string(out);
-}
+static void report_duplicates(PostgresPhotoRepository &repo) {
+  auto groups = repo.find_duplicates();
+  if (!groups) {
+    std::println(stderr, "Error: {}", groups.error());
+    return;
+  }
 
-/**
- * @brief Helper to calculate GPS Coordinates from Exiv2 Rational
- */
-double get_gps_coordinate(const Exiv2::ExifData& exifData, const char* key, const char* refKey) {
-    try {
-        auto pos = exifData.findKey(Exiv2::ExifKey(key));
-        if (pos == exifData.end() || pos->count() < 3) return 0.0;
-
-        double degrees = pos->toRational(0).first / (double)pos->toRational(0).second;
-        double minutes = pos->toRational(1).first / (double)pos->toRational(1).second;
-        double seconds = pos->toRational(2).first / (double)pos->toRational(2).second;
-
-        double decimal = degrees + (minutes / 60.0) + (seconds / 3600.0);
-
-        auto refPos = exifData.findKey(Exiv2::ExifKey(refKey));
-        if (refPos != exifData.end()) {
-            std::string ref = refPos->toString();
-            if (ref == "S" || ref == "W") decimal *= -1.0;
-        }
-        return decimal;
-    } catch (...) {
-        return 0.0;
-    }
+  std::size_t redundant = 0;
+  for (const auto &group : *groups) {
+    std::println("{} ({} copies)", group.content_hash, group.file_paths.size());
+    for (const auto &path : group.file_paths)
+      std::println("  {}", path);
+    redundant += group.file_paths.size() - 1;
+  }
+  std::println("--------------------------------------------------");
+  std::println("{} duplicate groups, {} redundant files.", groups->size(),
+               redundant);
 }
 
 /**
- * @brief Helper to calculate Altitude
+ * @brief Adds every photo below root to the import queue.
  */
-double get_gps_altitude(const Exiv2::ExifData& exifData) {
-    try {
-        auto pos = exifData.findKey(Exiv2::ExifKey("Exif.GPSInfo.GPSAltitude"));
-        if (pos == exifData.end() || pos->count() < 1) return 0.0;
-
-        double alt = pos->toRational(0).first / (double)pos->toRational(0).second;
-
-        auto refPos = exifData.findKey(Exiv2::ExifKey("Exif.GPSInfo.GPSAltitudeRef"));
-        if (refPos != exifData.end()) {
-            if (refPos->toLong() == 1) alt *= -1.0;
-        }
-        return alt;
-    } catch (...) {
-        return 0.0;
-    }
-}
+static void enqueue_tree(PostgresImportJobRepository &jobs,
+                         const fs::path &root) {
+  constexpr std::size_t chunk = 1000;
+  std::mutex mutex;
+  std::vector<std::string> files;
+  std::size_t queued = 0;
+  std::size_t seen = 0;
+  auto flush = [&] {
+    auto res = jobs.enqueue(root.string(), files);
+    if (!res)
+      std::println(stderr, "Error: {}", res.error());
+    else
+      queued += *res;
+    files.clear();
+  };
+
+  auto scanned = importer::scan_tree(root, [&](std::string &&path) {
+    std::lock_guard lock(mutex);
+    files.push_back(std::move(path));
+    ++seen;
+    if (files.size() == chunk)
+      flush();
+  });
+  if (!scanned)
+    std::println(stderr, "Error: {}", scanned.error());
+  if (!files.empty())
+    flush();
 
-/**
- * @brief Parses Exif DateTime string to system_clock::time_point
- */
-std::optional<std::chrono::system_clock::time_point> parse_exif_date(const std::string& date_str) {
-    if (date_str.empty()) return std::nullopt;
-    std::tm tm = {};
-    std::istringstream ss(date_str);
-    // Exif format is typically "YYYY:MM:DD HH:MM:SS"
-    ss >> std::get_time(&tm, "%Y:%m:%d %H:%M:%S");
-    if (ss.fail()) return std::nullopt;
-    return std::chrono::system_clock::from_time_t(std::mktime(&tm));
+  std::println("--------------------------------------------------");
+  std::println("{} files found, {} queued.", seen, queued);
 }
 
 /**
- * @brief Extracts date from filename using regex patterns
+ * @brief Unpacks the photos of each archive below root and submits them
+ * with their bytes, so every original is written once and never read back.
  */
-std::optional<std::chrono::system_clock::time_point> parse_date_from_filename(const std::string& filename) {
-    // Patterns: YYYYMMDD_HHMMSS or YYYY-MM-DD HH.MM.SS etc.
-    static const std::vector<std::pair<std::regex, std::string>> patterns = {
-        {std::regex("(\\d{4})(\\d{2})(\\d{2})_(\\d{2})(\\d{2})(\\d{2})"), "%Y%m%d_%H%M%S"},
-        {std::regex("(\\d{4})-(\\d{2})-(\\d{2})[ _](\\d{2})[\\.-](\\d{2})[\\.-](\\d{2})"), "%Y-%m-%d %H:%M:%S"}
-    };
-
-    for (const auto& [re, fmt] : patterns) {
-        std::smatch match;
-        if (std::regex_search(filename, match, re)) {
-            std::tm tm = {};
-            tm.tm_year = std::stoi(match[1]) - 1900;
-            tm.tm_mon = std::stoi(match[2]) - 1;
-            tm.tm_mday = std::stoi(match[3]);
-            tm.tm_hour = std::stoi(match[4]);
-            tm.tm_min = std::stoi(match[5]);
-            tm.tm_sec = std::stoi(match[6]);
-            return std::chrono::system_clock::from_time_t(std::mktime(&tm));
-        }
+static void import_archives(importer::ImportPipeline &pipeline,
+                            const fs::path &root,
+                            const std::vector<fs::path> &archives) {
+  for (const auto &archive : archives) {
+    std::size_t failed = 0;
+    auto result = importer::read_archive(
+        archive, [&](importer::ArchiveEntry &&entry) {
+          // Inside the library the entry's path is an ordinary relative
+          // path, so PathParser derives the location from it as usual.
+          const auto target = root / entry.path;
+          if (auto res = importer::write_original(target, entry); !res) {
+            std::println(stderr, "  ✗ Error unpacking {}: {}",
+                         entry.path.string(), res.error());
+            ++failed;
+            return;
+          }
+          pipeline.submit(root, target, std::move(entry.data));
+        });
+    if (!result) {
+      std::println(stderr, "Error: {}", result.error());
+      continue;
     }
-    return std::nullopt;
+    std::println("{}: {} photos ({} MiB) unpacked, {} other entries skipped, "
+                 "{} failed.",
+                 archive.string(), result->photos - failed,
+                 result->bytes >> 20, result->skipped, failed);
+  }
 }
 
 /**
- * @brief Retrieves an existing location ID or creates a new one
+ * @brief Prints what a reconciliation run found and changed.
  */
-std::string get_or_create_location(const infra::util::GeoInfo &geo) {
-  auto db = drogon::app().getDbClient("default");
-
-  auto res =
-      db->execSqlSync("SELECT id FROM locations WHERE continent = $1 AND "
-                      "country = $2 AND province = $3 AND city = $4",
-                      geo.continent.value_or(""), geo.country.value_or(""),
-                      geo.province.value_or(""), geo.city.value_or(""));
-
-  if (!res.empty()) {
-    return res[0]["id"].as<std::string>();
-  }
-
-  std::string loc_id = generate_uuid();
-  db->execSqlSync("INSERT INTO locations (id, continent, country, province, "
-                  "city) VALUES ($1, $2, $3, $4, $5)",
-                  loc_id, geo.continent.value_or(""), geo.country.value_or(""),
-                  geo.province.value_or(""), geo.city.value_or(""));
-  return loc_id;
+static void print_reconcile_report(const importer::ReconcileReport &report,
+                                   bool dry_run) {
+  std::println("--------------------------------------------------");
+  std::println("Reconciled {} files against {} rows and {} thumbnails{}.",
+               report.files, report.rows, report.thumbnails,
+               dry_run ? " (dry run, nothing changed)" : "");
+  std::println("{} stale rows, {} new files, {} orphaned thumbnails.",
+               report.stale_rows, report.new_files, report.orphans);
+  std::println("{} missing thumbnails, {} photos re-rendered, {} failures.",
+               report.missing, report.regenerated, report.failed);
 }
 
 /**
- * @brief Processes a single photo file with robust date fallback logic
+ * @brief Prints what a regeneration run found and rendered.
  */
-void process_photo(const fs::path &base_path, const fs::path &file_path) {
-  auto geo_path = infra::util::PathParser::parse(base_path, file_path);
-  std::string loc_id = get_or_create_location(geo_path);
-
-  Photo photo;
-  photo.id = generate_uuid();
-  photo.file_name = file_path.filename().string();
-  photo.file_path = file_path.string();
-  photo.location_id = loc_id;
-
-  std::map<std::string, std::string> exif_map;
-  std::map<std::string, std::string> iptc_map;
-  std::map<std::string, std::string> xmp_map;
-  std::vector<std::string> tags;
-
+static void print_regenerate_report(const importer::ReconcileReport &report,
+                                    bool dry_run) {
   std::println("--------------------------------------------------");
-  std::println("Processing: {}", file_path.filename().string());
-
-  try {
-    Magick::Image image;
-    image.read(file_path.string());
-    photo.width = (int)image.columns();
-    photo.height = (int)image.rows();
-
-    try {
-      auto exiv_image = Exiv2::ImageFactory::open(file_path.string());
-      exiv_image->readMetadata();
-      
-      // 1. EXIF
-      auto &exifData = exiv_image->exifData();
-      if (!exifData.empty()) {
-          for (auto it = exifData.begin(); it != exifData.end(); ++it) {
-              exif_map[it->key()] = it->toString();
-          }
-          photo.camera_make = exifData["Exif.Image.Make"].toString();
-          photo.camera_model = exifData["Exif.Image.Model"].toString();
-          
-          // Date Fallback Logic Step 1 & 2: EXIF
-          photo.taken_at = parse_exif_date(exifData["Exif.Photo.DateTimeOriginal"].toString());
-          if (!photo.taken_at) {
-              photo.taken_at = parse_exif_date(exifData["Exif.Image.DateTime"].toString());
-          }
-          
-          photo.gps_lat = get_gps_coordinate(exifData, "Exif.GPSInfo.GPSLatitude", "Exif.GPSInfo.GPSLatitudeRef");
-          photo.gps_lon = get_gps_coordinate(exifData, "Exif.GPSInfo.GPSLongitude", "Exif.GPSInfo.GPSLongitudeRef");
-          photo.gps_alt = get_gps_altitude(exifData);
-      }
-
-      // 2. IPTC
-      auto &iptcData = exiv_image->iptcData();
-      if (!iptcData.empty()) {
-          for (auto it = iptcData.begin(); it != iptcData.end(); ++it) {
-              iptc_map[it->key()] = it->toString();
-              if (it->key() == "Iptc.Application2.Keywords") {
-                  tags.push_back(it->toString());
-              }
-          }
-      }
-
-      // 3. XMP
-      auto &xmpData = exiv_image->xmpData();
-      if (!xmpData.empty()) {
-          for (auto it = xmpData.begin(); it != xmpData.end(); ++it) {
-              xmp_map[it->key()] = it->toString();
-              if (it->key() == "Xmp.dc.subject") {
-                  tags.push_back(it->toString());
-              }
-          }
-      }
-
-    } catch (...) {}
-
-    // Date Fallback Logic Step 3: Filename
-    if (!photo.taken_at) {
-        photo.taken_at = parse_date_from_filename(photo.file_name);
-    }
-
-    // Date Fallback Logic Step 4: File System Last Modified
-    if (!photo.taken_at) {
-        auto ftime = fs::last_write_time(file_path);
-        auto sctp = std::chrono::time_point_cast<std::chrono::system_clock::duration>(
-            ftime - fs::file_time_type::clock::now() + std::chrono::system_clock::now()
-        );
-        photo.taken_at = sctp;
-    }
-
-    std::vector<int> sizes = {480, 680, 800, 1024, 1280};
-    fs::path thumb_base = "/data/thumbs";
-    for (int size : sizes) {
-      fs::path relative_file = fs::relative(file_path, base_path);
-      fs::path size_path = thumb_base / std::to_string(size) / relative_file;
-      size_path.replace_extension(".webp");
-      fs::create_directories(size_path.parent_path());
-
-      Magick::Image thumb = image;
-      thumb.resize(Magick::Geometry(size, size));
-      thumb.magick("WEBP");
-      thumb.write(size_path.string());
-    }
-
-    photo.thumb_path =
-        fs::relative(file_path, base_path).replace_extension(".webp").string();
-
-    PostgresPhotoRepository repo;
-    repo.save(photo);
-
-    if (!exif_map.empty()) repo.save_metadata_exif(photo.id, exif_map);
-    if (!iptc_map.empty()) repo.save_metadata_iptc(photo.id, iptc_map);
-    if (!xmp_map.empty())  repo.save_metadata_xmp(photo.id, xmp_map);
-
-    for (const auto& tag : tags) {
-        repo.add_tag(photo.id, tag);
-    }
-
-    std::println("  ✓ Successfully imported with full metadata and resolved date.");
-
-  } catch (const std::exception &e) {
-    std::println(stderr, "  ✗ Error processing {}: {}",
-                 file_path.filename().string(), e.what());
-  }
+  std::println("Checked {} photos against {} thumbnails{}.", report.rows,
+               report.thumbnails, dry_run ? " (dry run, nothing changed)" : "");
+  std::println("{} missing thumbnails, {} photos rendered, {} failures.",
+               report.missing, report.regenerated, report.failed);
 }
 
 /**
  * @brief Main entry point
  */
 int main(int argc, char **argv) {
-  if (argc < 2) {
-    std::println("Usage: gallery-import <directory>");
+  // Thumbnail settings default to the configuration.
+  ConfigLoader::load("/app/.env");
+  auto options = importer::parse_import_options(argc, argv);
+  if (!options) {
+    std::println(stderr, "{}", options.error());
+    importer::print_usage();
     return 1;
   }
 
-  ConfigLoader::load("/app/.env");
-  Magick::InitializeMagick(*argv);
-  std::string root_path = argv[1];
+  importer::PhotoProcessor::init_codecs(*argv);
+  importer::PhotoProcessor::limit_memory(options->max_decode_mem);
+
+  importer::PipelineOptions pipeline_options;
+  pipeline_options.jobs = options->jobs;
+  pipeline_options.persist_batch_size = options->batch_size;
+  pipeline_options.max_decode_mem = options->max_decode_mem;
+  // JSON on stdout must not be interleaved with per-file lines.
+  pipeline_options.log_each_file = options->progress_json != "-";
+  if (options->metadata_only) {
+    // Only the metadata pages of each file are read: waiting on the disk
+    // dominates, so run more readers than cores and keep the kernel from
+    // reading whole files ahead. Nothing is decoded, so there is no budget.
+    if (pipeline_options.jobs == 0)
+      pipeline_options.jobs =
+          4 * std::max(1u, std::thread::hardware_concurrency());
+    pipeline_options.prefetch_files = false;
+    pipeline_options.max_decode_mem = 0;
+  }
+  // Queued archive entries carry their bytes; keep the backlog short.
+  if (!options->archives.empty())
+    pipeline_options.scan_queue_capacity = 16;
 
   Json::Value config;
   Json::Value db_client;
@@ -304,11 +212,38 @@ int main(int argc, char **argv) {
   db_client["dbname"] = ConfigLoader::get("DB_NAME", "gallery");
   db_client["user"] = ConfigLoader::get("DB_USER", "gallery_user");
   db_client["passwd"] = ConfigLoader::get("DB_PASSWORD", "");
-  db_client["connection_number"] = 1;
+  db_client["connection_number"] =
+      static_cast<Json::UInt>(pipeline_options.persist_workers);
   config["db_clients"].append(db_client);
   drogon::app().loadConfigJson(config);
 
-  std::thread worker([root_path]() {
+  importer::ProcessorOptions processor_options;
+  processor_options.thumb_sizes = options->thumb_sizes;
+  processor_options.thumb_root = options->thumb_root;
+  processor_options.resize_mode = options->resize_mode;
+  processor_options.shrink_on_load = options->shrink_on_load;
+  processor_options.use_previews = options->use_previews;
+  processor_options.full_metadata = options->full_metadata;
+  processor_options.engine = options->engine;
+  processor_options.encoder = options->encoder;
+  processor_options.webp = options->webp;
+  processor_options.metadata_only = options->metadata_only;
+
+  // Watch mode runs until drogon is stopped (SIGINT/SIGTERM).
+  std::stop_source stop;
+
+  std::thread worker([root = options->root, archives = options->archives,
+                      pipeline_options, processor_options,
+                      incremental = options->incremental,
+                      command = options->command, watch = options->watch,
+                      settle = std::chrono::milliseconds(options->settle_ms),
+                      progress_json = options->progress_json,
+                      progress_interval =
+                          std::chrono::seconds(options->progress_interval_s),
+                      lease = std::chrono::seconds(options->lease_s),
+                      dry_run = options->dry_run,
+                      thumb_store = options->thumb_store,
+                      stop_token = stop.get_token()]() mutable {
     std::this_thread::sleep_for(std::chrono::seconds(1));
     auto db = drogon::app().getDbClient("default");
     if (!db) {
@@ -326,23 +261,190 @@ int main(int argc, char **argv) {
       return;
     }
 
-    fs::path root = root_path;
-    for (const auto &entry : fs::recursive_directory_iterator(root)) {
-      if (entry.is_regular_file()) {
-        std::string ext = entry.path().extension().string();
-        for (auto &c : ext)
-          c = (char)std::tolower(c);
-        if (ext == ".jpg" || ext == ".jpeg" || ext == ".png") {
-          process_photo(root, entry.path());
-        }
+    if (command == importer::ImportCommand::Duplicates) {
+      PostgresPhotoRepository repo;
+      report_duplicates(repo);
+      drogon::app().quit();
+      return;
+    }
+
+    PostgresImportJobRepository job_repo;
+    if (command == importer::ImportCommand::Enqueue) {
+      enqueue_tree(job_repo, root);
+      drogon::app().quit();
+      return;
+    }
+
+    // Outcomes reach the queue through the pipeline's completion hook, so
+    // the worker has to exist before the pipeline.
+    std::optional<importer::JobQueueWorker> queue_worker;
+    if (command == importer::ImportCommand::Worker) {
+      importer::QueueWorkerOptions queue_options;
+      queue_options.lease = lease;
+      queue_worker.emplace(job_repo, queue_options);
+      pipeline_options.on_complete = [&](const importer::PhotoJob &job,
+                                         const char *error) {
+        queue_worker->on_complete(job, error);
+      };
+      std::println("Worker {} claiming jobs...", queue_worker->name());
+    }
+
+    PostgresImportManifestRepository manifest_repo;
+    importer::ImportManifest manifest(manifest_repo);
+    if (incremental) {
+      if (auto res = manifest.load(); !res) {
+        std::println(stderr, "Fatal: Could not load import manifest: {}",
+                     res.error());
+        drogon::app().quit();
+        return;
+      }
+      std::println("Incremental mode: {} files in manifest.", manifest.size());
+    }
+
+    PostgresLocationRepository location_repo;
+    importer::LocationCache locations(location_repo);
+    if (auto res = locations.preload(); !res) {
+      std::println(stderr, "Fatal: Could not load locations: {}", res.error());
+      drogon::app().quit();
+      return;
+    }
+
+    std::unique_ptr<std::FILE, int (*)(std::FILE *)> progress_file(
+        nullptr, &std::fclose);
+    std::FILE *progress_out = nullptr;
+    if (progress_json == "-") {
+      progress_out = stdout;
+    } else if (!progress_json.empty()) {
+      progress_file.reset(std::fopen(progress_json.c_str(), "a"));
+      if (!progress_file) {
+        std::println(stderr, "Fatal: Could not open {}", progress_json);
+        drogon::app().quit();
+        return;
       }
+      progress_out = progress_file.get();
     }
+
+    const auto started = std::chrono::steady_clock::now();
+    importer::ImportMetrics metrics;
+    PostgresPhotoRepository repo;
+    PostgresThumbnailPackRepository pack_repo;
+    importer::ThumbPackStore packs(pack_repo, processor_options.thumb_root);
+    importer::PhotoProcessor processor(
+        repo, locations, processor_options, incremental ? &manifest : nullptr,
+        &metrics, thumb_store == importer::ThumbStore::Packs ? &packs : nullptr);
+    if (command == importer::ImportCommand::Regenerate) {
+      importer::ReconcileOptions reconcile_options;
+      reconcile_options.dry_run = dry_run;
+      reconcile_options.log_each_file = pipeline_options.log_each_file;
+      reconcile_options.jobs = pipeline_options.jobs;
+      importer::Reconciler reconciler(repo, processor, reconcile_options);
+      if (auto report = reconciler.regenerate(root); !report)
+        std::println(stderr, "Error: Regeneration failed: {}", report.error());
+      else
+        print_regenerate_report(*report, dry_run);
+      drogon::app().quit();
+      return;
+    }
+
+    importer::ImportPipeline pipeline(processor, pipeline_options);
+    std::optional<importer::ProgressReporter> progress;
+    if (progress_out)
+      progress.emplace(pipeline, progress_out, progress_interval);
+
+    // Walker threads submit as they go; decoding starts with the first
+    // directory instead of after the whole tree is listed.
+    auto scan = [&] {
+      auto scanned = importer::scan_tree(
+          root, [&](std::string &&path) { pipeline.submit(root, path); });
+      if (!scanned)
+        std::println(stderr, "Error: {}", scanned.error());
+    };
+
+    // Watches go in before the initial scan so nothing slips through.
+    importer::DirectoryWatcher watcher(root, settle);
+    if (watch) {
+      if (auto res = watcher.start(); !res) {
+        std::println(stderr, "Fatal: {}", res.error());
+        pipeline.finish();
+        progress.reset();
+        drogon::app().quit();
+        return;
+      }
+    }
+
+    if (queue_worker) {
+      queue_worker->run(pipeline, stop_token);
+    } else if (command == importer::ImportCommand::Reconcile) {
+      importer::ReconcileOptions reconcile_options;
+      reconcile_options.dry_run = dry_run;
+      reconcile_options.log_each_file = pipeline_options.log_each_file;
+      reconcile_options.jobs = pipeline_options.jobs;
+      importer::Reconciler reconciler(repo, processor, reconcile_options);
+      auto report = reconciler.run(
+          root, [&](const fs::path &path) { pipeline.submit(root, path); });
+      if (!report)
+        std::println(stderr, "Error: Reconciliation failed: {}",
+                     report.error());
+      else
+        print_reconcile_report(*report, dry_run);
+      if (progress && !watch)
+        progress->mark_scan_complete();
+    } else if (!archives.empty()) {
+      import_archives(pipeline, root, archives);
+      if (progress)
+        progress->mark_scan_complete();
+    } else {
+      scan();
+      if (progress && !watch)
+        progress->mark_scan_complete();
+    }
+
+    if (watch) {
+      std::println("Watching {} ({} directories)...", root.string(),
+                   watcher.watch_count());
+      importer::WatchCallbacks callbacks;
+      callbacks.on_ready = [&](const fs::path &path) {
+        pipeline.submit(root, path);
+      };
+      callbacks.on_removed = [&](const fs::path &path) {
+        manifest.forget(path.string());
+        auto removed = repo.remove_by_path(path.string());
+        if (!removed)
+          std::println(stderr, "  ✗ Error removing {}: {}", path.string(),
+                       removed.error());
+        else if (*removed > 0)
+          std::println("  - {} ({} removed)", path.string(), *removed);
+      };
+      callbacks.on_overflow = scan;
+      watcher.run(stop_token, callbacks);
+    }
+    pipeline.finish();
+    progress.reset();
+
+    const auto &stats = pipeline.stats();
     std::println("--------------------------------------------------");
-    std::println("Import complete.");
+    std::println("Import complete: {} imported, {} unchanged, {} failed.",
+                 stats.imported.load(), stats.skipped.load(),
+                 stats.failed.load());
+    if (auto files = stats.files_read.load(); files > 0) {
+      std::println("Read {} MiB from {} originals ({} KiB per photo).",
+                   stats.bytes_read.load() >> 20, files,
+                   (stats.bytes_read.load() / files) >> 10);
+    }
+    const double elapsed = std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - started)
+                               .count();
+    if (elapsed > 0) {
+      std::println("{:.1f} s wall time, {:.1f} photos/s.", elapsed,
+                   static_cast<double>(stats.imported.load()) / elapsed);
+    }
+    std::println("");
+    metrics.print_summary(stdout);
     drogon::app().quit();
   });
 
   drogon::app().run();
+  stop.request_stop();
   worker.join();
   return 0;
 }
@@ -25,6 +25,7 @@
 #include "api/controllers/auth_controller.hpp"
 #include "api/controllers/location_controller.hpp"
 #include "api/controllers/photo_controller.hpp"
+#include "api/controllers/thumbnail_controller.hpp"
 #include "api/controllers/user_controller.hpp"
 
 using namespace core::config;
@@ -0,0 +1,89 @@
+/**
+ * SPDX-FileComment: Import Job Queue Repository Interface
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file i_import_job_repository.hpp
+ * @brief Interface for the queue shared by distributed import workers
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include "domain/models/photo_models.hpp"
+#include <chrono>
+#include <cstdint>
+#include <expected>
+#include <string>
+#include <vector>
+
+namespace domain::interfaces {
+
+using namespace domain::models;
+
+/**
+ * @class IImportJobRepository
+ * @brief Work queue of files to import.
+ *
+ * A job is claimed with a lease. A worker that dies simply lets the lease
+ * run out, after which another worker may claim the job again until
+ * max_attempts is reached.
+ */
+class IImportJobRepository {
+public:
+  virtual ~IImportJobRepository() = default;
+
+  /**
+   * @brief Adds files as pending jobs. Files already done or failed are
+   * queued again; pending and running ones are left alone.
+   * @return Number of rows inserted or reset.
+   */
+  virtual std::expected<std::size_t, std::string>
+  enqueue(const std::string &base_path,
+          const std::vector<std::string> &file_paths) = 0;
+
+  /**
+   * @brief Claims up to @p limit pending (or lease-expired) jobs.
+   */
+  virtual std::expected<std::vector<ImportJob>, std::string>
+  claim(const std::string &worker, std::size_t limit,
+        std::chrono::seconds lease) = 0;
+
+  /**
+   * @brief Extends the lease of jobs the worker still holds.
+   */
+  virtual std::expected<void, std::string>
+  renew(const std::string &worker, const std::vector<std::int64_t> &ids,
+        std::chrono::seconds lease) = 0;
+
+  /**
+   * @brief Marks jobs as done.
+   */
+  virtual std::expected<void, std::string>
+  complete(const std::string &worker, const std::vector<std::int64_t> &ids) = 0;
+
+  /**
+   * @brief Records a failure; the job returns to pending unless it has used
+   * up its attempts.
+   */
+  virtual std::expected<void, std::string>
+  fail(const std::string &worker, std::int64_t id,
+       const std::string &error) = 0;
+
+  /**
+   * @brief Marks jobs failed whose lease expired on their last attempt.
+   */
+  virtual std::expected<std::size_t, std::string> expire_exhausted() = 0;
+
+  virtual std::expected<ImportJobCounts, std::string> counts() = 0;
+};
+
+} // namespace domain::interfaces
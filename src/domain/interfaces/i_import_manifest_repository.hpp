@@ -0,0 +1,48 @@
+/**
+ * SPDX-FileComment: Import Manifest Repository Interface
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file i_import_manifest_repository.hpp
+ * @brief Interface for the importer's file manifest
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include "domain/models/photo_models.hpp"
+#include <expected>
+#include <string>
+#include <vector>
+
+/**
+ * @namespace domain::interfaces
+ * @brief Namespace for domain interfaces.
+ */
+namespace domain::interfaces {
+
+using namespace domain::models;
+
+/**
+ * @class IImportManifestRepository
+ * @brief Interface for reading and updating the import manifest.
+ */
+class IImportManifestRepository {
+public:
+  virtual ~IImportManifestRepository() = default;
+
+  virtual std::expected<std::vector<ManifestEntry>, std::string>
+  find_all() = 0;
+  virtual std::expected<void, std::string>
+  upsert(const ManifestEntry &entry) = 0;
+};
+
+} // namespace domain::interfaces
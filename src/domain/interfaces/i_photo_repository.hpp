@@ -7,8 +7,8 @@
  *
  * @file i_photo_repository.hpp
  * @brief Interfaces for Photo and Location Repositories
- * @version 0.1.0
- * @date 2026-02-24
+ * @version 0.1.1
+ * @date 2026-10-17
  *
  * @author ZHENG Robert (robert@hase-zheng.net)
  * @copyright Copyright (c) 2026 ZHENG Robert
@@ -56,7 +56,51 @@ public:
   find_all(const PhotoFilter &filter) = 0;
   virtual std::expected<std::optional<Photo>, std::string>
   find_by_id(std::string_view id) = 0;
-  virtual std::expected<void, std::string> save(const Photo &photo) = 0;
+  /**
+   * @brief Inserts or updates a photo keyed by file_path.
+   * @return The canonical id of the stored row, which is the existing id
+   * when the file was imported before.
+   */
+  virtual std::expected<std::string, std::string>
+  save(const Photo &photo) = 0;
+  /**
+   * @brief Stores several photos together with their EXIF/IPTC/XMP maps and
+   * tags in a single transaction.
+   * @return Canonical ids in the order of @p photos.
+   */
+  virtual std::expected<std::vector<std::string>, std::string>
+  save_batch(const std::vector<Photo> &photos) = 0;
+  /**
+   * @brief Replaces the EXIF/IPTC/XMP rows and tags of photos already
+   * stored for the same file_path, in a single transaction. The photo rows
+   * themselves are left alone.
+   * @return An error, and no change, if any file has no stored photo.
+   */
+  virtual std::expected<void, std::string>
+  replace_metadata_batch(const std::vector<Photo> &photos) = 0;
+  virtual std::expected<std::optional<Photo>, std::string>
+  find_by_content_hash(std::string_view content_hash) = 0;
+  virtual std::expected<std::vector<DuplicateGroup>, std::string>
+  find_duplicates() = 0;
+  /**
+   * @brief Deletes the photo stored for a file, or every photo below a
+   * directory. Pack index entries no remaining photo uses go with them.
+   * @return Number of deleted photos.
+   */
+  virtual std::expected<std::size_t, std::string>
+  remove_by_path(std::string_view path) = 0;
+  /**
+   * @brief File and thumbnail path of every photo, in no particular order.
+   */
+  virtual std::expected<std::vector<PhotoPaths>, std::string>
+  list_paths() = 0;
+  /**
+   * @brief Deletes the photos stored for exactly these files, like
+   * remove_by_path().
+   * @return Number of deleted photos.
+   */
+  virtual std::expected<std::size_t, std::string>
+  remove_paths(const std::vector<std::string> &file_paths) = 0;
   virtual std::expected<void, std::string> add_tag(std::string_view photo_id,
                                                    std::string_view tag) = 0;
   virtual std::expected<void, std::string> save_metadata_exif(std::string_view photo_id, const std::map<std::string, std::string>& metadata) = 0;
@@ -74,6 +118,7 @@ public:
 
   virtual std::expected<std::vector<Location>, std::string>
   get_tree(bool only_public = false) = 0;
+  virtual std::expected<std::vector<Location>, std::string> find_all() = 0;
   virtual std::expected<std::optional<Location>, std::string>
   find_or_create(const Location &loc) = 0;
 };
@@ -0,0 +1,65 @@
+/**
+ * SPDX-FileComment: Thumbnail Pack Index Repository Interface
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file i_thumbnail_pack_repository.hpp
+ * @brief Interface for the index of thumbnails stored in pack files
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include "domain/models/photo_models.hpp"
+#include <expected>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace domain::interfaces {
+
+using namespace domain::models;
+
+/**
+ * @class IThumbnailPackRepository
+ * @brief Maps (thumb_path, size) to a byte range of a pack file.
+ */
+class IThumbnailPackRepository {
+public:
+  virtual ~IThumbnailPackRepository() = default;
+
+  /**
+   * @brief Stores the locations; an existing entry for the same thumb_path
+   * and size is replaced (the old bytes stay unreferenced in their pack).
+   */
+  virtual std::expected<void, std::string>
+  record(const std::vector<PackedThumbnail> &thumbnails) = 0;
+
+  /**
+   * @return std::nullopt if the thumbnail is not stored in a pack.
+   */
+  virtual std::expected<std::optional<PackedThumbnail>, std::string>
+  find(const std::string &thumb_path, int size) = 0;
+
+  /**
+   * @brief thumb_path of every entry of one size.
+   */
+  virtual std::expected<std::vector<std::string>, std::string>
+  list(int size) = 0;
+
+  /**
+   * @brief Deletes the entries of one size; the bytes stay in their packs.
+   */
+  virtual std::expected<void, std::string>
+  remove(int size, const std::vector<std::string> &thumb_paths) = 0;
+};
+
+} // namespace domain::interfaces
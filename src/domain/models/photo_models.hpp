@@ -7,8 +7,8 @@
  *
  * @file photo_models.hpp
  * @brief Domain models for photos and locations
- * @version 0.1.0
- * @date 2026-02-24
+ * @version 0.1.1
+ * @date 2026-10-17
  *
  * @author ZHENG Robert (robert@hase-zheng.net)
  * @copyright Copyright (c) 2026 ZHENG Robert
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <map>
 #include <optional>
 #include <string>
@@ -65,6 +66,9 @@ struct Photo {
   std::optional<double> gps_lat;
   std::optional<double> gps_lon;
   std::optional<double> gps_alt;
+  std::optional<std::string> content_hash;
+  std::optional<std::string> blurhash;       ///< Placeholder for the grid.
+  std::optional<std::string> dominant_color; ///< Average color, "#rrggbb".
   bool is_public = true;
   std::chrono::system_clock::time_point created_at;
 
@@ -74,4 +78,69 @@ struct Photo {
   std::map<std::string, std::string> xmp;
 };
 
+/**
+ * @struct DuplicateGroup
+ * @brief Photos whose originals are byte-identical.
+ */
+struct DuplicateGroup {
+  std::string content_hash;
+  std::vector<std::string> file_paths;
+};
+
+/**
+ * @struct PhotoPaths
+ * @brief The columns reconciliation compares against the filesystem.
+ */
+struct PhotoPaths {
+  std::string file_path;
+  std::optional<std::string> thumb_path;
+};
+
+/**
+ * @struct ManifestEntry
+ * @brief File state recorded by the importer to detect unchanged files.
+ */
+struct ManifestEntry {
+  std::string file_path;
+  std::int64_t file_size = 0;
+  std::int64_t mtime_ns = 0;
+  std::int64_t inode = 0;
+  std::string content_hash;
+  std::optional<std::string> photo_id;
+};
+
+/**
+ * @struct PackedThumbnail
+ * @brief Where one thumbnail size of a photo lives inside a pack file.
+ */
+struct PackedThumbnail {
+  std::string thumb_path; ///< Same key as photos.thumb_path.
+  int size = 0;           ///< Bounding-box edge length.
+  std::string pack;       ///< Pack file relative to the thumbnail root.
+  std::int64_t offset = 0;
+  std::int64_t length = 0;
+};
+
+/**
+ * @struct ImportJob
+ * @brief A file claimed from the distributed import queue.
+ */
+struct ImportJob {
+  std::int64_t id = 0;
+  std::string base_path;
+  std::string file_path;
+  int attempts = 0; ///< Including the current one.
+};
+
+/**
+ * @struct ImportJobCounts
+ * @brief Number of import_jobs rows per status.
+ */
+struct ImportJobCounts {
+  std::size_t pending = 0;
+  std::size_t running = 0;
+  std::size_t done = 0;
+  std::size_t failed = 0;
+};
+
 } // namespace domain::models
@@ -0,0 +1,246 @@
+/**
+ * SPDX-FileComment: Streams photos out of ZIP/TAR archives
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file archive_reader.cpp
+ * @brief Reads photo entries of ZIP/TAR archives into memory via libarchive
+ * (built with GALLERY_HAVE_ARCHIVE)
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "archive_reader.hpp"
+#include "directory_scanner.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <format>
+#include <memory>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef GALLERY_HAVE_ARCHIVE
+#include <archive.h>
+#include <archive_entry.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace importer {
+
+bool archive_import_available() {
+#ifdef GALLERY_HAVE_ARCHIVE
+  return true;
+#else
+  return false;
+#endif
+}
+
+#ifdef GALLERY_HAVE_ARCHIVE
+namespace {
+
+constexpr std::size_t kReadBlock = 1 << 20;
+
+/// Normalised entry path, or nothing if it would leave the target
+/// directory.
+std::optional<fs::path> safe_path(const char *name) {
+  if (!name || !*name)
+    return std::nullopt;
+  auto path = fs::path(name).lexically_normal();
+  if (path.empty() || path.has_root_path())
+    return std::nullopt;
+  for (const auto &part : path) {
+    if (part == "..")
+      return std::nullopt;
+  }
+  return path;
+}
+
+/// macOS Finder adds "__MACOSX/.../._IMG_0001.JPG" resource forks to ZIPs;
+/// they carry a photo extension but no image.
+bool is_resource_fork(const fs::path &path) {
+  return *path.begin() == "__MACOSX" ||
+         path.filename().string().starts_with("._");
+}
+
+std::expected<FileBuffer, std::string> read_data(archive *reader,
+                                                 archive_entry *entry,
+                                                 const fs::path &name) {
+  // Streamed ZIP entries with a data descriptor have no size in the header;
+  // the buffer then grows as needed.
+  std::size_t capacity = kReadBlock;
+  if (archive_entry_size_is_set(entry) && archive_entry_size(entry) > 0)
+    capacity = static_cast<std::size_t>(archive_entry_size(entry));
+  auto data = std::make_unique_for_overwrite<std::uint8_t[]>(capacity);
+  std::size_t size = 0;
+
+  auto fail = [&] {
+    return std::unexpected(
+        std::format("{}: {}", name.string(), archive_error_string(reader)));
+  };
+  for (;;) {
+    if (size == capacity) {
+      // Usually the exact size from the header: check for the end before
+      // doubling the buffer.
+      std::uint8_t probe;
+      la_ssize_t n = archive_read_data(reader, &probe, 1);
+      if (n < 0)
+        return fail();
+      if (n == 0)
+        break;
+      capacity *= 2;
+      auto grown = std::make_unique_for_overwrite<std::uint8_t[]>(capacity);
+      std::copy_n(data.get(), size, grown.get());
+      data = std::move(grown);
+      data[size++] = probe;
+    }
+    la_ssize_t n =
+        archive_read_data(reader, data.get() + size, capacity - size);
+    if (n < 0)
+      return fail();
+    if (n == 0)
+      break;
+    size += static_cast<std::size_t>(n);
+  }
+  return FileBuffer::adopt(std::move(data), size);
+}
+
+} // namespace
+
+std::expected<ArchiveResult, std::string>
+read_archive(const fs::path &archive_path,
+             const std::function<void(ArchiveEntry &&entry)> &on_entry) {
+  std::unique_ptr<archive, int (*)(archive *)> reader(archive_read_new(),
+                                                      &archive_read_free);
+  if (!reader)
+    return std::unexpected("Out of memory creating the archive reader");
+  archive_read_support_filter_all(reader.get());
+  archive_read_support_format_zip(reader.get());
+  archive_read_support_format_tar(reader.get());
+  if (archive_read_open_filename(reader.get(), archive_path.c_str(),
+                                 kReadBlock) != ARCHIVE_OK) {
+    return std::unexpected(std::format("open {}: {}", archive_path.string(),
+                                       archive_error_string(reader.get())));
+  }
+
+  ArchiveResult result;
+  for (;;) {
+    archive_entry *entry = nullptr;
+    int rc = archive_read_next_header(reader.get(), &entry);
+    if (rc == ARCHIVE_EOF)
+      break;
+    if (rc == ARCHIVE_RETRY)
+      continue;
+    if (rc < ARCHIVE_WARN) {
+      return std::unexpected(std::format("{}: {}", archive_path.string(),
+                                         archive_error_string(reader.get())));
+    }
+
+    // The next header skips whatever data is not read here.
+    auto path = safe_path(archive_entry_pathname(entry));
+    if (archive_entry_filetype(entry) != AE_IFREG || !path ||
+        is_resource_fork(*path) ||
+        !has_photo_extension(path->filename().string())) {
+      ++result.skipped;
+      continue;
+    }
+
+    auto data = read_data(reader.get(), entry, *path);
+    if (!data)
+      return std::unexpected(data.error());
+    if (data->empty()) {
+      ++result.skipped;
+      continue;
+    }
+
+    ArchiveEntry photo;
+    photo.path = std::move(*path);
+    photo.data = std::move(*data);
+    if (archive_entry_mtime_is_set(entry) && archive_entry_mtime(entry) >= 0) {
+      photo.mtime_ns = static_cast<std::int64_t>(archive_entry_mtime(entry)) *
+                           1'000'000'000 +
+                       archive_entry_mtime_nsec(entry);
+    }
+    ++result.photos;
+    result.bytes += photo.data.size();
+    on_entry(std::move(photo));
+  }
+  return result;
+}
+#else
+std::expected<ArchiveResult, std::string>
+read_archive(const fs::path &archive_path,
+             const std::function<void(ArchiveEntry &&entry)> &) {
+  return std::unexpected(
+      std::format("{}: this build does not include libarchive",
+                  archive_path.string()));
+}
+#endif // GALLERY_HAVE_ARCHIVE
+
+std::expected<void, std::string> write_original(const fs::path &path,
+                                                const ArchiveEntry &entry) {
+  std::error_code ec;
+  fs::create_directories(path.parent_path(), ec);
+  if (ec) {
+    return std::unexpected(std::format(
+        "create {}: {}", path.parent_path().string(), ec.message()));
+  }
+
+  auto partial = path;
+  partial += ".part";
+  int fd = ::open(partial.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                  0644);
+  if (fd < 0) {
+    return std::unexpected(
+        std::format("open {}: {}", partial.string(), std::strerror(errno)));
+  }
+
+  // First failing step and its errno; later cleanup must not clobber it.
+  const char *step = nullptr;
+  int error = 0;
+  auto failed = [&](const char *what) {
+    step = what;
+    error = errno;
+  };
+  const auto bytes = entry.data.bytes();
+  std::size_t written = 0;
+  while (written < bytes.size()) {
+    ssize_t n = ::write(fd, bytes.data() + written, bytes.size() - written);
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      failed("write");
+      break;
+    }
+    written += static_cast<std::size_t>(n);
+  }
+  if (!step && entry.mtime_ns) {
+    const struct timespec times[2] = {
+        {0, UTIME_OMIT},
+        {static_cast<time_t>(*entry.mtime_ns / 1'000'000'000),
+         static_cast<long>(*entry.mtime_ns % 1'000'000'000)}};
+    if (::futimens(fd, times) != 0)
+      failed("set mtime of");
+  }
+  if (::close(fd) != 0 && !step)
+    failed("close");
+  if (!step && ::rename(partial.c_str(), path.c_str()) != 0)
+    failed("rename");
+  if (step) {
+    ::unlink(partial.c_str());
+    return std::unexpected(std::format("{} {}: {}", step, partial.string(),
+                                       std::strerror(error)));
+  }
+  return {};
+}
+
+} // namespace importer
@@ -0,0 +1,90 @@
+/**
+ * SPDX-FileComment: Streams photos out of ZIP/TAR archives
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file archive_reader.hpp
+ * @brief Reads photo entries of ZIP/TAR archives into memory via libarchive
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include "file_buffer.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace importer {
+
+/**
+ * @struct ArchiveEntry
+ * @brief One photo read out of an archive.
+ */
+struct ArchiveEntry {
+  /// Path inside the archive, normalised and guaranteed to stay below the
+  /// directory it is resolved against.
+  std::filesystem::path path;
+  FileBuffer data; ///< Uncompressed contents.
+  std::optional<std::int64_t> mtime_ns; ///< Modification time, if recorded.
+};
+
+/**
+ * @struct ArchiveResult
+ * @brief Totals of a finished archive read.
+ */
+struct ArchiveResult {
+  std::size_t photos = 0;  ///< Entries passed to the callback.
+  std::size_t skipped = 0; ///< Directories, links, other files, unsafe paths.
+  std::uint64_t bytes = 0; ///< Uncompressed size of the photos.
+};
+
+/**
+ * @brief Whether this build includes libarchive; it is optional.
+ */
+bool archive_import_available();
+
+/**
+ * @brief Reads every photo (has_photo_extension()) of a ZIP or TAR
+ * archive, one entry at a time.
+ *
+ * gzip, bzip2, xz and zstd compression of TAR archives is detected from
+ * the data. Entries are decompressed straight into a FileBuffer, so
+ * nothing is unpacked to disk; only one entry is held by the reader at a
+ * time. Entries whose path is absolute or climbs out with ".." are
+ * skipped.
+ *
+ * @param archive Archive file.
+ * @param on_entry Called on the calling thread, in archive order. It may
+ * block, which throttles decompression.
+ * @return Totals, or an error if the archive cannot be opened or is
+ * corrupt, or the build has no libarchive. Entries before the damage have
+ * already been passed on.
+ */
+std::expected<ArchiveResult, std::string>
+read_archive(const std::filesystem::path &archive,
+             const std::function<void(ArchiveEntry &&entry)> &on_entry);
+
+/**
+ * @brief Writes an entry to @p path, creating parent directories.
+ *
+ * The bytes go to "<path>.part" first and are renamed into place, so
+ * neither the scanner nor a watcher sees a half-written photo. The entry's
+ * modification time is carried over when the archive recorded one.
+ */
+std::expected<void, std::string>
+write_original(const std::filesystem::path &path, const ArchiveEntry &entry);
+
+} // namespace importer
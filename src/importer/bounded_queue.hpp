@@ -0,0 +1,123 @@
+/**
+ * SPDX-FileComment: Bounded blocking queue for the import pipeline
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file bounded_queue.hpp
+ * @brief Fixed-capacity MPMC queue providing backpressure between stages
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+/**
+ * @namespace importer
+ * @brief Namespace for the gallery-import pipeline components.
+ */
+namespace importer {
+
+/**
+ * @class BoundedQueue
+ * @brief Multi-producer/multi-consumer queue with a fixed capacity.
+ *
+ * push() blocks while the queue is full, so a slow consumer throttles its
+ * producers instead of letting items pile up in memory.
+ */
+template <typename T> class BoundedQueue {
+public:
+  explicit BoundedQueue(std::size_t capacity)
+      : capacity_(capacity == 0 ? 1 : capacity) {}
+
+  BoundedQueue(const BoundedQueue &) = delete;
+  BoundedQueue &operator=(const BoundedQueue &) = delete;
+
+  /**
+   * @brief Appends an item, blocking while the queue is full.
+   * @return false if the queue was closed and the item was not enqueued.
+   */
+  bool push(T item) {
+    std::unique_lock lock(mutex_);
+    not_full_.wait(lock,
+                   [this] { return closed_ || items_.size() < capacity_; });
+    if (closed_)
+      return false;
+    items_.push_back(std::move(item));
+    lock.unlock();
+    not_empty_.notify_one();
+    return true;
+  }
+
+  /**
+   * @brief Removes the oldest item, blocking while the queue is empty.
+   * @return std::nullopt once the queue is closed and drained.
+   */
+  std::optional<T> pop() {
+    std::unique_lock lock(mutex_);
+    not_empty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+    if (items_.empty())
+      return std::nullopt;
+    T item = std::move(items_.front());
+    items_.pop_front();
+    lock.unlock();
+    not_full_.notify_one();
+    return item;
+  }
+
+  /**
+   * @brief Removes the oldest item if one is available, without blocking.
+   */
+  std::optional<T> try_pop() {
+    std::unique_lock lock(mutex_);
+    if (items_.empty())
+      return std::nullopt;
+    T item = std::move(items_.front());
+    items_.pop_front();
+    lock.unlock();
+    not_full_.notify_one();
+    return item;
+  }
+
+  /**
+   * @brief Rejects further pushes and wakes all waiters. Remaining items can
+   * still be popped.
+   */
+  void close() {
+    {
+      std::lock_guard lock(mutex_);
+      closed_ = true;
+    }
+    not_empty_.notify_all();
+    not_full_.notify_all();
+  }
+
+  std::size_t size() const {
+    std::lock_guard lock(mutex_);
+    return items_.size();
+  }
+
+  std::size_t capacity() const { return capacity_; }
+
+private:
+  const std::size_t capacity_;
+  mutable std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::deque<T> items_;
+  bool closed_ = false;
+};
+
+} // namespace importer
@@ -0,0 +1,72 @@
+/**
+ * SPDX-FileComment: Thumbnail derivative generator implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file derivative_generator.cpp
+ * @brief Builds the thumbnail ladder of a decoded original
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "derivative_generator.hpp"
+#include <algorithm>
+#include <functional>
+
+namespace importer {
+
+std::optional<ResizeMode> parse_resize_mode(std::string_view name) {
+  if (name == "cascade")
+    return ResizeMode::Cascade;
+  if (name == "independent")
+    return ResizeMode::Independent;
+  return std::nullopt;
+}
+
+DerivativeGenerator::DerivativeGenerator(std::vector<int> sizes,
+                                         ResizeMode mode)
+    : sizes_(std::move(sizes)), mode_(mode) {
+  std::ranges::sort(sizes_, std::greater<>());
+  sizes_.erase(std::unique(sizes_.begin(), sizes_.end()), sizes_.end());
+}
+
+std::vector<Thumbnail>
+DerivativeGenerator::generate(const Raster &original,
+                              const Raster *preview) const {
+  std::vector<Thumbnail> out;
+  out.reserve(sizes_.size());
+  if (sizes_.empty())
+    return out;
+
+  const auto preview_edge =
+      preview ? std::max(preview->width, preview->height) : 0;
+  auto base_for = [&](int size) -> const Raster & {
+    return preview && covers(preview_edge, size) ? *preview : original;
+  };
+
+  // An original that already fits the largest box gets enlarged by the first
+  // resize; cascading from that enlargement would only add blur, and
+  // resizing such a small original directly is cheap anyway.
+  const auto &first = base_for(sizes_.front());
+  const auto first_edge = std::max(first.width, first.height);
+  const bool cascade = mode_ == ResizeMode::Cascade &&
+                       first_edge > static_cast<std::size_t>(sizes_.front());
+
+  for (int size : sizes_) {
+    // Cascading from a larger derivative beats going back to the preview:
+    // it is smaller and was itself rendered from the best source.
+    const Raster &source =
+        (cascade && !out.empty()) ? out.back().pixels : base_for(size);
+    out.push_back({size, resize_to_box(source, size)});
+  }
+  return out;
+}
+
+} // namespace importer
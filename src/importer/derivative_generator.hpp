@@ -0,0 +1,93 @@
+/**
+ * SPDX-FileComment: Thumbnail derivative generator
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file derivative_generator.hpp
+ * @brief Builds the thumbnail ladder of a decoded original
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include "resampler.hpp"
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace importer {
+
+/**
+ * @enum ResizeMode
+ * @brief How the smaller derivatives are derived.
+ */
+enum class ResizeMode {
+  Cascade,    ///< Resize the original once, then each size from the previous.
+  Independent ///< Resize every size from the full-resolution original.
+};
+
+/**
+ * @brief Parses "cascade" / "independent".
+ */
+std::optional<ResizeMode> parse_resize_mode(std::string_view name);
+
+/**
+ * @struct Thumbnail
+ * @brief One rendered size of the ladder.
+ */
+struct Thumbnail {
+  int size; ///< Box edge the image was fitted into.
+  Raster pixels;
+};
+
+/**
+ * @class DerivativeGenerator
+ * @brief Produces resized copies of an original for a ladder of box sizes.
+ *
+ * In Cascade mode only the largest size is resampled from the original; every
+ * smaller size is resampled from the next larger derivative, which turns N
+ * full-resolution resamples into one. Independent mode reproduces the
+ * original per-size behaviour for output comparisons. Resampling goes
+ * through resize_to_box(), which picks the filters ImageMagick's resize
+ * would.
+ */
+class DerivativeGenerator {
+public:
+  DerivativeGenerator(std::vector<int> sizes, ResizeMode mode);
+
+  /**
+   * @brief Renders all sizes.
+   * @param preview Smaller rendition of the same frame (embedded camera
+   * preview). Sizes its long edge covers are resampled from it instead of
+   * from the original; if it covers the largest size, @p original is not
+   * used and may be empty.
+   * @return Thumbnails ordered from the largest to the smallest size.
+   */
+  std::vector<Thumbnail> generate(const Raster &original,
+                                  const Raster *preview = nullptr) const;
+
+  /**
+   * @brief Whether an image with the given long edge covers a size
+   * without enlarging.
+   */
+  static bool covers(std::size_t edge, int size) {
+    return edge >= static_cast<std::size_t>(size);
+  }
+
+  const std::vector<int> &sizes() const { return sizes_; }
+  ResizeMode mode() const { return mode_; }
+
+private:
+  std::vector<int> sizes_; ///< Sorted descending.
+  ResizeMode mode_;
+};
+
+} // namespace importer
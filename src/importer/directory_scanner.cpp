@@ -0,0 +1,212 @@
+/**
+ * SPDX-FileComment: Parallel directory scanner implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file directory_scanner.cpp
+ * @brief Walks a directory tree on several threads with getdents64
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "directory_scanner.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace importer {
+
+namespace {
+
+/// Kernel record layout returned by getdents64(2).
+struct LinuxDirent64 {
+  std::uint64_t d_ino;
+  std::int64_t d_off;
+  unsigned short d_reclen;
+  unsigned char d_type;
+  char d_name[1];
+};
+
+constexpr std::size_t kBufferSize = 64 * 1024;
+
+/**
+ * @brief Directories still to be read, shared by all walker threads.
+ *
+ * LIFO order keeps the walk close to depth-first, so the stack stays small
+ * even for very wide trees.
+ */
+class DirectoryStack {
+public:
+  void push(std::string dir) {
+    {
+      std::lock_guard lock(mutex_);
+      dirs_.push_back(std::move(dir));
+      ++outstanding_;
+    }
+    ready_.notify_one();
+  }
+
+  /// Blocks for the next directory; false once the whole tree is done.
+  bool pop(std::string &dir) {
+    std::unique_lock lock(mutex_);
+    ready_.wait(lock, [this] { return !dirs_.empty() || outstanding_ == 0; });
+    if (dirs_.empty())
+      return false;
+    dir = std::move(dirs_.back());
+    dirs_.pop_back();
+    return true;
+  }
+
+  /// Marks a popped directory as fully read (its children already pushed).
+  void done() {
+    bool finished = false;
+    {
+      std::lock_guard lock(mutex_);
+      finished = --outstanding_ == 0;
+    }
+    if (finished)
+      ready_.notify_all();
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  std::vector<std::string> dirs_;
+  std::size_t outstanding_ = 0; ///< Pushed but not yet done().
+};
+
+bool is_dot_entry(const char *name) {
+  return name[0] == '.' &&
+         (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+}
+
+} // namespace
+
+bool has_photo_extension(std::string_view file_name) {
+  const auto dot = file_name.rfind('.');
+  if (dot == std::string_view::npos || dot == 0)
+    return false;
+  const auto ext = file_name.substr(dot + 1);
+  auto equals = [ext](std::string_view expected) {
+    return std::ranges::equal(ext, expected, [](char a, char b) {
+      return (a >= 'A' && a <= 'Z' ? a + ('a' - 'A') : a) == b;
+    });
+  };
+  return equals("jpg") || equals("jpeg") || equals("png");
+}
+
+std::expected<ScanResult, std::string>
+scan_tree(const std::filesystem::path &root,
+          const std::function<void(std::string &&path)> &on_file,
+          ScanOptions options) {
+  std::string top = root.string();
+  while (top.size() > 1 && top.back() == '/')
+    top.pop_back();
+
+  // Fail early and clearly if the root itself is unusable.
+  {
+    int fd = ::open(top.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0)
+      return std::unexpected(
+          std::format("Cannot read {}: {}", top, std::strerror(errno)));
+    ::close(fd);
+  }
+
+  std::size_t threads = options.threads;
+  if (threads == 0)
+    threads = std::clamp<std::size_t>(std::thread::hardware_concurrency(), 4,
+                                      16);
+
+  DirectoryStack stack;
+  std::atomic<std::size_t> directories{0};
+  std::atomic<std::size_t> files{0};
+  std::atomic<std::size_t> unreadable{0};
+
+  auto walk_one = [&](const std::string &dir, char *buffer) {
+    int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+      unreadable.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    directories.fetch_add(1, std::memory_order_relaxed);
+    const std::string prefix = dir == "/" ? dir : dir + "/";
+
+    for (;;) {
+      const long n = ::syscall(SYS_getdents64, fd, buffer, kBufferSize);
+      if (n <= 0)
+        break;
+      for (long offset = 0; offset < n;) {
+        const auto *entry =
+            reinterpret_cast<const LinuxDirent64 *>(buffer + offset);
+        offset += entry->d_reclen;
+        const char *name = entry->d_name;
+        if (is_dot_entry(name))
+          continue;
+
+        unsigned char type = entry->d_type;
+        if (type == DT_UNKNOWN || type == DT_LNK) {
+          // Symlinks are resolved like is_regular_file() would; unknown
+          // types need a stat of their own.
+          struct stat st {};
+          const int flags = type == DT_LNK ? 0 : AT_SYMLINK_NOFOLLOW;
+          if (::fstatat(fd, name, &st, flags) != 0)
+            continue;
+          if (S_ISREG(st.st_mode))
+            type = DT_REG;
+          else if (S_ISDIR(st.st_mode) && entry->d_type == DT_UNKNOWN)
+            type = DT_DIR;
+          else
+            continue;
+        }
+
+        if (type == DT_DIR) {
+          stack.push(prefix + name);
+        } else if (type == DT_REG) {
+          if (options.photos_only && !has_photo_extension(name))
+            continue;
+          files.fetch_add(1, std::memory_order_relaxed);
+          on_file(prefix + name);
+        }
+      }
+    }
+    ::close(fd);
+  };
+
+  stack.push(top);
+  std::vector<std::jthread> walkers;
+  walkers.reserve(threads);
+  for (std::size_t i = 0; i < threads; ++i) {
+    walkers.emplace_back([&] {
+      auto buffer = std::make_unique_for_overwrite<char[]>(kBufferSize);
+      std::string dir;
+      while (stack.pop(dir)) {
+        walk_one(dir, buffer.get());
+        stack.done();
+      }
+    });
+  }
+  walkers.clear(); // Joins.
+
+  return ScanResult{directories.load(), files.load(), unreadable.load()};
+}
+
+} // namespace importer
@@ -0,0 +1,77 @@
+/**
+ * SPDX-FileComment: Parallel directory scanner
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file directory_scanner.hpp
+ * @brief Walks a directory tree on several threads with getdents64
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace importer {
+
+/**
+ * @brief True if a file name ends in .jpg, .jpeg or .png (any case).
+ */
+bool has_photo_extension(std::string_view file_name);
+
+/**
+ * @struct ScanOptions
+ * @brief Settings of a tree scan.
+ */
+struct ScanOptions {
+  std::size_t threads = 0; ///< Walker threads; 0 = cores, clamped to 4..16.
+  bool photos_only = true; ///< Report only names has_photo_extension() takes.
+};
+
+/**
+ * @struct ScanResult
+ * @brief Totals of a finished scan.
+ */
+struct ScanResult {
+  std::size_t directories = 0;
+  std::size_t files = 0;      ///< Files passed to the callback.
+  std::size_t unreadable = 0; ///< Subdirectories that could not be opened.
+};
+
+/**
+ * @brief Reports every regular file below @p root.
+ *
+ * Directories are read with getdents64 into a 64 KiB buffer and classified
+ * by d_type, so a file costs no stat() and no path object unless it passes
+ * the filter. Only file systems that leave d_type unset (DT_UNKNOWN) get
+ * an fstatat() per entry. Subdirectories go to a shared stack that all
+ * walker threads drain, so wide trees are read in parallel from the
+ * start. Like std::filesystem::recursive_directory_iterator, symlinked
+ * files are reported and symlinked directories are not entered.
+ *
+ * @param root Directory to walk. Reported paths start with it.
+ * @param on_file Called with each file's path, concurrently from the walker
+ * threads and in no particular order. It may block, which throttles the
+ * walk.
+ * @return Totals, or an error if @p root itself cannot be read.
+ * Unreadable subdirectories are skipped and counted.
+ */
+std::expected<ScanResult, std::string>
+scan_tree(const std::filesystem::path &root,
+          const std::function<void(std::string &&path)> &on_file,
+          ScanOptions options = {});
+
+} // namespace importer
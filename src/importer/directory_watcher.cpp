@@ -0,0 +1,226 @@
+/**
+ * SPDX-FileComment: inotify-based watcher for the import root implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file directory_watcher.cpp
+ * @brief Reports new, changed and removed photos below a directory tree
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "directory_watcher.hpp"
+#include "directory_scanner.hpp"
+#include "file_fingerprint.hpp"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <poll.h>
+#include <print>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace importer {
+
+namespace {
+constexpr std::uint32_t kDirMask = IN_CREATE | IN_MODIFY | IN_CLOSE_WRITE |
+                                   IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE |
+                                   IN_ONLYDIR;
+/// Upper bound for one poll() so stop requests are noticed promptly.
+constexpr int kMaxPollMs = 500;
+} // namespace
+
+bool is_supported_photo(const fs::path &path) {
+  return has_photo_extension(path.filename().native());
+}
+
+DirectoryWatcher::DirectoryWatcher(fs::path root,
+                                   std::chrono::milliseconds settle_delay)
+    : root_(std::move(root)), settle_delay_(settle_delay) {}
+
+DirectoryWatcher::~DirectoryWatcher() {
+  if (fd_ >= 0)
+    ::close(fd_);
+}
+
+std::expected<void, std::string> DirectoryWatcher::start() {
+  fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (fd_ < 0)
+    return std::unexpected(
+        std::format("inotify_init1 failed: {}", std::strerror(errno)));
+  add_tree(root_, false);
+  if (watches_.empty())
+    return std::unexpected(
+        std::format("Could not watch {}", root_.string()));
+  return {};
+}
+
+void DirectoryWatcher::add_tree(const fs::path &dir, bool announce_files) {
+  auto add = [this](const fs::path &path) {
+    int wd = inotify_add_watch(fd_, path.c_str(), kDirMask);
+    if (wd >= 0) {
+      watches_.insert_or_assign(wd, path);
+    } else if (errno == ENOSPC && !limit_warned_) {
+      limit_warned_ = true;
+      std::println(stderr,
+                   "Warning: inotify watch limit reached at {}; raise "
+                   "fs.inotify.max_user_watches",
+                   path.string());
+    }
+  };
+
+  add(dir);
+  std::error_code ec;
+  for (fs::recursive_directory_iterator it(
+           dir, fs::directory_options::skip_permission_denied, ec),
+       end;
+       it != end; it.increment(ec)) {
+    if (ec)
+      break;
+    if (it->is_directory(ec)) {
+      add(it->path());
+    } else if (announce_files && it->is_regular_file(ec)) {
+      // Copied in before its directory was watched.
+      touch(it->path());
+    }
+  }
+}
+
+void DirectoryWatcher::drop_tree(const fs::path &dir) {
+  const auto prefix = dir.string() + "/";
+  std::erase_if(watches_, [&](const auto &item) {
+    const auto path = item.second.string();
+    if (path != dir.string() && !path.starts_with(prefix))
+      return false;
+    inotify_rm_watch(fd_, item.first);
+    return true;
+  });
+  std::erase_if(pending_, [&](const auto &item) {
+    return item.first.starts_with(prefix);
+  });
+}
+
+void DirectoryWatcher::touch(const fs::path &path) {
+  if (!is_supported_photo(path))
+    return;
+  auto &pending = pending_[path.string()];
+  pending.due = Clock::now() + settle_delay_;
+}
+
+void DirectoryWatcher::flush_settled(const WatchCallbacks &callbacks) {
+  const auto now = Clock::now();
+  std::vector<fs::path> ready;
+
+  for (auto it = pending_.begin(); it != pending_.end();) {
+    auto &pending = it->second;
+    if (pending.due > now) {
+      ++it;
+      continue;
+    }
+    auto fp = stat_fingerprint(it->first);
+    if (!fp) {
+      it = pending_.erase(it); // Gone again (temp file, aborted copy).
+      continue;
+    }
+    if (fp->size != pending.size || fp->mtime_ns != pending.mtime_ns) {
+      // Still growing, or never checked: look again after another delay.
+      pending.size = fp->size;
+      pending.mtime_ns = fp->mtime_ns;
+      pending.due = now + settle_delay_;
+      ++it;
+      continue;
+    }
+    ready.emplace_back(it->first);
+    it = pending_.erase(it);
+  }
+
+  std::ranges::sort(ready);
+  for (const auto &path : ready)
+    callbacks.on_ready(path);
+}
+
+int DirectoryWatcher::next_timeout_ms() const {
+  auto timeout = kMaxPollMs;
+  const auto now = Clock::now();
+  for (const auto &[path, pending] : pending_) {
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                  pending.due - now)
+                  .count();
+    timeout = std::clamp<int>(static_cast<int>(ms), 0, timeout);
+  }
+  return timeout;
+}
+
+void DirectoryWatcher::run(std::stop_token stop,
+                           const WatchCallbacks &callbacks) {
+  alignas(inotify_event) std::array<char, 64 * 1024> buffer;
+
+  while (!stop.stop_requested()) {
+    pollfd pfd{fd_, POLLIN, 0};
+    int ready = ::poll(&pfd, 1, next_timeout_ms());
+    if (ready < 0 && errno != EINTR) {
+      std::println(stderr, "Watch: poll failed: {}", std::strerror(errno));
+      return;
+    }
+
+    if (ready > 0) {
+      for (;;) {
+        auto len = ::read(fd_, buffer.data(), buffer.size());
+        if (len <= 0)
+          break;
+
+        for (char *p = buffer.data(); p < buffer.data() + len;) {
+          const auto *event = reinterpret_cast<const inotify_event *>(p);
+          p += sizeof(inotify_event) + event->len;
+
+          if (event->mask & IN_Q_OVERFLOW) {
+            std::println(stderr, "Watch: event queue overflow, rescanning");
+            add_tree(root_, false);
+            callbacks.on_overflow();
+            continue;
+          }
+          if (event->mask & IN_IGNORED) {
+            watches_.erase(event->wd);
+            continue;
+          }
+
+          auto dir = watches_.find(event->wd);
+          if (dir == watches_.end() || event->len == 0)
+            continue;
+          const fs::path path = dir->second / event->name;
+
+          if (event->mask & IN_ISDIR) {
+            if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+              add_tree(path, true);
+            } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+              drop_tree(path);
+              callbacks.on_removed(path);
+            }
+          } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+            pending_.erase(path.string());
+            if (is_supported_photo(path))
+              callbacks.on_removed(path);
+          } else {
+            touch(path);
+          }
+        }
+      }
+    }
+
+    flush_settled(callbacks);
+  }
+}
+
+} // namespace importer
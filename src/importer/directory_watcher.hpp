@@ -0,0 +1,107 @@
+/**
+ * SPDX-FileComment: inotify-based watcher for the import root
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file directory_watcher.hpp
+ * @brief Reports new, changed and removed photos below a directory tree
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <stop_token>
+#include <string>
+#include <unordered_map>
+
+namespace importer {
+
+/**
+ * @brief True for the file types gallery-import handles (.jpg/.jpeg/.png).
+ */
+bool is_supported_photo(const std::filesystem::path &path);
+
+/**
+ * @struct WatchCallbacks
+ * @brief Receivers for the events of a DirectoryWatcher.
+ */
+struct WatchCallbacks {
+  /// A photo was created, replaced or moved in and has stopped changing.
+  std::function<void(const std::filesystem::path &)> on_ready;
+  /// A file or a whole directory was deleted or moved out.
+  std::function<void(const std::filesystem::path &)> on_removed;
+  /// The kernel dropped events; the caller should rescan the tree.
+  std::function<void()> on_overflow;
+};
+
+/**
+ * @class DirectoryWatcher
+ * @brief Recursive inotify watch with debouncing.
+ *
+ * inotify is not recursive, so every directory gets its own watch and new
+ * subdirectories are added as they appear. A file is only reported once
+ * its size and mtime have stayed the same for the settle delay, which
+ * covers slow network copies that open and close the file several times.
+ */
+class DirectoryWatcher {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit DirectoryWatcher(std::filesystem::path root,
+                            std::chrono::milliseconds settle_delay =
+                                std::chrono::milliseconds(2000));
+  ~DirectoryWatcher();
+
+  DirectoryWatcher(const DirectoryWatcher &) = delete;
+  DirectoryWatcher &operator=(const DirectoryWatcher &) = delete;
+
+  /**
+   * @brief Creates the inotify instance and watches the existing tree.
+   *
+   * Call this before the initial scan so files arriving during the scan
+   * are not missed.
+   */
+  std::expected<void, std::string> start();
+
+  /**
+   * @brief Dispatches events until a stop is requested.
+   */
+  void run(std::stop_token stop, const WatchCallbacks &callbacks);
+
+  std::size_t watch_count() const { return watches_.size(); }
+
+private:
+  struct Pending {
+    Clock::time_point due;
+    std::int64_t size = -1;
+    std::int64_t mtime_ns = -1;
+  };
+
+  void add_tree(const std::filesystem::path &dir, bool announce_files);
+  void drop_tree(const std::filesystem::path &dir);
+  void touch(const std::filesystem::path &path);
+  void flush_settled(const WatchCallbacks &callbacks);
+  int next_timeout_ms() const;
+
+  std::filesystem::path root_;
+  std::chrono::milliseconds settle_delay_;
+  int fd_ = -1;
+  bool limit_warned_ = false;
+  std::unordered_map<int, std::filesystem::path> watches_;
+  std::unordered_map<std::string, Pending> pending_;
+};
+
+} // namespace importer
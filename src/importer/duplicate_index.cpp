@@ -0,0 +1,80 @@
+/**
+ * SPDX-FileComment: Content-hash index for duplicate originals
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file duplicate_index.cpp
+ * @brief Lets byte-identical originals share one set of derivatives
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "duplicate_index.hpp"
+
+namespace importer {
+
+DuplicateIndex::DuplicateIndex(domain::interfaces::IPhotoRepository &photos)
+    : photos_(photos) {}
+
+std::optional<SharedDerivatives>
+DuplicateIndex::claim(const std::string &content_hash,
+                      const SharedDerivatives &mine) {
+  {
+    std::lock_guard lock(mutex_);
+    if (auto it = owners_.find(content_hash); it != owners_.end()) {
+      // Until the owner is stored its thumbnails may never appear.
+      if (!it->second.published ||
+          it->second.derivatives.thumb_path == mine.thumb_path)
+        return std::nullopt;
+      return it->second.derivatives;
+    }
+  }
+
+  // Query outside the lock; a concurrent claim for the same hash is settled
+  // by the try_emplace below.
+  SharedDerivatives candidate = mine;
+  bool from_db = false;
+  if (auto existing = photos_.find_by_content_hash(content_hash);
+      existing && *existing && (*existing)->thumb_path) {
+    candidate = {*(*existing)->thumb_path, (*existing)->width,
+                 (*existing)->height};
+    from_db = true;
+  }
+
+  std::lock_guard lock(mutex_);
+  // Rows already in the table had their thumbnails written.
+  auto it = owners_.try_emplace(content_hash, Owner{candidate, from_db}).first;
+  if (!it->second.published)
+    return std::nullopt;
+  // Re-importing the owner itself must render again.
+  if (it->second.derivatives.thumb_path == mine.thumb_path)
+    return std::nullopt;
+  return it->second.derivatives;
+}
+
+void DuplicateIndex::publish(const std::string &content_hash,
+                             const SharedDerivatives &mine) {
+  std::lock_guard lock(mutex_);
+  auto it = owners_.find(content_hash);
+  if (it != owners_.end() && it->second.derivatives.thumb_path ==
+                                 mine.thumb_path)
+    it->second = {mine, true};
+}
+
+void DuplicateIndex::release(const std::string &content_hash,
+                             const std::string &thumb_path) {
+  std::lock_guard lock(mutex_);
+  auto it = owners_.find(content_hash);
+  if (it != owners_.end() && !it->second.published &&
+      it->second.derivatives.thumb_path == thumb_path)
+    owners_.erase(it);
+}
+
+} // namespace importer
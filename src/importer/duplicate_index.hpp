@@ -0,0 +1,87 @@
+/**
+ * SPDX-FileComment: Content-hash index for duplicate originals
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file duplicate_index.hpp
+ * @brief Lets byte-identical originals share one set of derivatives
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include "domain/interfaces/i_photo_repository.hpp"
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace importer {
+
+/**
+ * @struct SharedDerivatives
+ * @brief Derivatives owned by the first photo imported with a given hash.
+ */
+struct SharedDerivatives {
+  std::string thumb_path;
+  std::optional<int> width;
+  std::optional<int> height;
+};
+
+/**
+ * @class DuplicateIndex
+ * @brief Maps content hashes to the derivatives rendered for them.
+ *
+ * Hashes seen in this run are answered from memory, earlier imports from the
+ * photos table. The first claim for a hash becomes its pending owner and
+ * renders the thumbnails. Only once the owner is persisted does publish()
+ * let later claims reuse its thumb_path; until then they render for
+ * themselves. A failed owner calls release() so the next claim can take
+ * over.
+ */
+class DuplicateIndex {
+public:
+  explicit DuplicateIndex(domain::interfaces::IPhotoRepository &photos);
+
+  /**
+   * @brief Registers @p mine as owner of @p content_hash unless another
+   * photo already owns it.
+   * @return The published owner's derivatives, or std::nullopt if the
+   * caller must render its own: it now owns the hash, or the owner has not
+   * been persisted yet.
+   */
+  std::optional<SharedDerivatives> claim(const std::string &content_hash,
+                                         const SharedDerivatives &mine);
+
+  /**
+   * @brief Makes @p mine available to later claims once its thumbnails
+   * and row are stored. No-op unless @p mine is the pending owner.
+   */
+  void publish(const std::string &content_hash, const SharedDerivatives &mine);
+
+  /**
+   * @brief Gives up a pending ownership after the owner failed. No-op
+   * unless @p thumb_path belongs to the pending owner.
+   */
+  void release(const std::string &content_hash, const std::string &thumb_path);
+
+private:
+  struct Owner {
+    SharedDerivatives derivatives;
+    bool published = false;
+  };
+
+  domain::interfaces::IPhotoRepository &photos_;
+  std::mutex mutex_;
+  std::unordered_map<std::string, Owner> owners_;
+};
+
+} // namespace importer
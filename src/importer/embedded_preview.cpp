@@ -0,0 +1,68 @@
+/**
+ * SPDX-FileComment: Embedded preview extraction implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file embedded_preview.cpp
+ * @brief Finds and decodes the camera preview stored inside an original
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "embedded_preview.hpp"
+#include <algorithm>
+#include <cmath>
+#include <exiv2/exiv2.hpp>
+
+namespace importer {
+
+// Relative aspect ratio difference still treated as the same frame; covers
+// previews whose edges were rounded to a multiple of 8 or 16.
+static constexpr double kAspectTolerance = 0.02;
+
+std::optional<Magick::Image>
+read_embedded_preview(std::span<const std::uint8_t> data, int width,
+                      int height, int min_edge) {
+  if (width <= 0 || height <= 0)
+    return std::nullopt;
+  const double aspect = static_cast<double>(width) / height;
+
+  try {
+    auto image = Exiv2::ImageFactory::open(data.data(), data.size());
+    image->readMetadata();
+    Exiv2::PreviewManager previews(*image);
+
+    const Exiv2::PreviewProperties *best = nullptr;
+    auto list = previews.getPreviewProperties();
+    for (const auto &p : list) {
+      if (p.width_ == 0 || p.height_ == 0)
+        continue;
+      if (static_cast<int>(std::max(p.width_, p.height_)) < min_edge)
+        continue;
+      const double preview_aspect = static_cast<double>(p.width_) / p.height_;
+      if (std::abs(preview_aspect / aspect - 1.0) > kAspectTolerance)
+        continue;
+      if (!best || p.width_ * p.height_ > best->width_ * best->height_)
+        best = &p;
+    }
+    if (!best)
+      return std::nullopt;
+
+    auto preview = previews.getPreviewImage(*best);
+    Magick::Image decoded;
+    decoded.read(Magick::Blob(preview.pData(), preview.size()));
+    return decoded;
+  } catch (const std::exception &) {
+    // Unknown container or broken preview: fall back to the main image.
+    return std::nullopt;
+  }
+}
+
+} // namespace importer
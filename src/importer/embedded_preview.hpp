@@ -0,0 +1,48 @@
+/**
+ * SPDX-FileComment: Embedded preview extraction
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file embedded_preview.hpp
+ * @brief Finds and decodes the camera preview stored inside an original
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include <Magick++.h>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace importer {
+
+/**
+ * @brief Decodes the largest usable preview embedded in an original.
+ *
+ * Exiv2's PreviewManager lists the EXIF thumbnail, JPEG previews in
+ * MakerNotes and the full-size previews of RAW containers. A preview is
+ * only usable if it shows the whole frame, i.e. its aspect ratio matches
+ * the original's (some cameras store letterboxed 16:9 or cropped
+ * previews), and if its long edge reaches @p min_edge.
+ *
+ * @param data Complete file contents.
+ * @param width Width of the main image.
+ * @param height Height of the main image.
+ * @param min_edge Smallest long edge worth decoding.
+ * @return The decoded preview, or std::nullopt if there is none or Exiv2
+ * cannot read the container.
+ */
+std::optional<Magick::Image>
+read_embedded_preview(std::span<const std::uint8_t> data, int width,
+                      int height, int min_edge);
+
+} // namespace importer
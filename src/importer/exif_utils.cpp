@@ -0,0 +1,101 @@
+/**
+ * SPDX-FileComment: EXIF value helpers implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file exif_utils.cpp
+ * @brief GPS and date conversion helpers shared by the importer stages
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "exif_utils.hpp"
+#include <ctime>
+#include <iomanip>
+#include <regex>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace importer {
+
+double get_gps_coordinate(const Exiv2::ExifData& exifData, const char* key, const char* refKey) {
+    try {
+        auto pos = exifData.findKey(Exiv2::ExifKey(key));
+        if (pos == exifData.end() || pos->count() < 3) return 0.0;
+
+        double degrees = pos->toRational(0).first / (double)pos->toRational(0).second;
+        double minutes = pos->toRational(1).first / (double)pos->toRational(1).second;
+        double seconds = pos->toRational(2).first / (double)pos->toRational(2).second;
+
+        double decimal = degrees + (minutes / 60.0) + (seconds / 3600.0);
+
+        auto refPos = exifData.findKey(Exiv2::ExifKey(refKey));
+        if (refPos != exifData.end()) {
+            std::string ref = refPos->toString();
+            if (ref == "S" || ref == "W") decimal *= -1.0;
+        }
+        return decimal;
+    } catch (...) {
+        return 0.0;
+    }
+}
+
+double get_gps_altitude(const Exiv2::ExifData& exifData) {
+    try {
+        auto pos = exifData.findKey(Exiv2::ExifKey("Exif.GPSInfo.GPSAltitude"));
+        if (pos == exifData.end() || pos->count() < 1) return 0.0;
+
+        double alt = pos->toRational(0).first / (double)pos->toRational(0).second;
+
+        auto refPos = exifData.findKey(Exiv2::ExifKey("Exif.GPSInfo.GPSAltitudeRef"));
+        if (refPos != exifData.end()) {
+            if (refPos->toLong() == 1) alt *= -1.0;
+        }
+        return alt;
+    } catch (...) {
+        return 0.0;
+    }
+}
+
+std::optional<std::chrono::system_clock::time_point> parse_exif_date(const std::string& date_str) {
+    if (date_str.empty()) return std::nullopt;
+    std::tm tm = {};
+    std::istringstream ss(date_str);
+    // Exif format is typically "YYYY:MM:DD HH:MM:SS"
+    ss >> std::get_time(&tm, "%Y:%m:%d %H:%M:%S");
+    if (ss.fail()) return std::nullopt;
+    return std::chrono::system_clock::from_time_t(std::mktime(&tm));
+}
+
+std::optional<std::chrono::system_clock::time_point> parse_date_from_filename(const std::string& filename) {
+    // Patterns: YYYYMMDD_HHMMSS or YYYY-MM-DD HH.MM.SS etc.
+    static const std::vector<std::pair<std::regex, std::string>> patterns = {
+        {std::regex("(\\d{4})(\\d{2})(\\d{2})_(\\d{2})(\\d{2})(\\d{2})"), "%Y%m%d_%H%M%S"},
+        {std::regex("(\\d{4})-(\\d{2})-(\\d{2})[ _](\\d{2})[\\.-](\\d{2})[\\.-](\\d{2})"), "%Y-%m-%d %H:%M:%S"}
+    };
+
+    for (const auto& [re, fmt] : patterns) {
+        std::smatch match;
+        if (std::regex_search(filename, match, re)) {
+            std::tm tm = {};
+            tm.tm_year = std::stoi(match[1]) - 1900;
+            tm.tm_mon = std::stoi(match[2]) - 1;
+            tm.tm_mday = std::stoi(match[3]);
+            tm.tm_hour = std::stoi(match[4]);
+            tm.tm_min = std::stoi(match[5]);
+            tm.tm_sec = std::stoi(match[6]);
+            return std::chrono::system_clock::from_time_t(std::mktime(&tm));
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace importer
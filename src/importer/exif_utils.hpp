@@ -0,0 +1,51 @@
+/**
+ * SPDX-FileComment: EXIF value helpers for the import pipeline
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file exif_utils.hpp
+ * @brief GPS and date conversion helpers shared by the importer stages
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include <chrono>
+#include <exiv2/exiv2.hpp>
+#include <optional>
+#include <string>
+
+namespace importer {
+
+/**
+ * @brief Helper to calculate GPS Coordinates from Exiv2 Rational
+ */
+double get_gps_coordinate(const Exiv2::ExifData &exifData, const char *key,
+                          const char *refKey);
+
+/**
+ * @brief Helper to calculate Altitude
+ */
+double get_gps_altitude(const Exiv2::ExifData &exifData);
+
+/**
+ * @brief Parses Exif DateTime string to system_clock::time_point
+ */
+std::optional<std::chrono::system_clock::time_point>
+parse_exif_date(const std::string &date_str);
+
+/**
+ * @brief Extracts date from filename using regex patterns
+ */
+std::optional<std::chrono::system_clock::time_point>
+parse_date_from_filename(const std::string &filename);
+
+} // namespace importer
@@ -0,0 +1,83 @@
+/**
+ * SPDX-FileComment: Read-once buffer for an original file implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file file_buffer.cpp
+ * @brief Holds the bytes of an original so every stage shares one read
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "file_buffer.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <format>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace importer {
+
+std::expected<FileBuffer, std::string>
+FileBuffer::read(const std::filesystem::path &path) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return std::unexpected(
+        std::format("open {}: {}", path.string(), std::strerror(errno)));
+  }
+  std::unique_ptr<int, void (*)(int *)> guard(&fd, [](int *f) { ::close(*f); });
+
+  struct stat st {};
+  if (::fstat(fd, &st) != 0) {
+    return std::unexpected(
+        std::format("stat {}: {}", path.string(), std::strerror(errno)));
+  }
+  ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+  FileBuffer buffer;
+  const auto capacity = static_cast<std::size_t>(st.st_size);
+  buffer.data_ = std::make_unique_for_overwrite<std::uint8_t[]>(capacity);
+  while (buffer.size_ < capacity) {
+    ssize_t n = ::pread(fd, buffer.data_.get() + buffer.size_,
+                        capacity - buffer.size_,
+                        static_cast<off_t>(buffer.size_));
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      return std::unexpected(
+          std::format("read {}: {}", path.string(), std::strerror(errno)));
+    }
+    if (n == 0)
+      break; // Truncated since fstat(); keep what is there.
+    buffer.size_ += static_cast<std::size_t>(n);
+  }
+  if (buffer.size_ == 0)
+    return std::unexpected(std::format("{} is empty", path.string()));
+  return buffer;
+}
+
+FileBuffer FileBuffer::adopt(std::unique_ptr<std::uint8_t[]> data,
+                             std::size_t size) {
+  FileBuffer buffer;
+  buffer.data_ = std::move(data);
+  buffer.size_ = size;
+  return buffer;
+}
+
+void prefetch_file(const std::filesystem::path &path) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return;
+  ::posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+  ::close(fd);
+}
+
+} // namespace importer
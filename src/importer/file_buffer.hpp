@@ -0,0 +1,81 @@
+/**
+ * SPDX-FileComment: Read-once buffer for an original file
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file file_buffer.hpp
+ * @brief Holds the bytes of an original so every stage shares one read
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace importer {
+
+/**
+ * @class FileBuffer
+ * @brief The complete contents of a file, read with a single pass.
+ *
+ * Hashing, header parsing, Exiv2 and the decoder all work on these bytes,
+ * so each original is read from disk exactly once. A heap buffer is used
+ * rather than mmap: a file truncated on an NFS share while mapped would
+ * raise SIGBUS instead of a read error.
+ */
+class FileBuffer {
+public:
+  FileBuffer() = default;
+
+  /**
+   * @brief Reads the whole file.
+   */
+  static std::expected<FileBuffer, std::string>
+  read(const std::filesystem::path &path);
+
+  /**
+   * @brief Takes over bytes that are already in memory, such as an entry
+   * streamed out of an archive.
+   */
+  static FileBuffer adopt(std::unique_ptr<std::uint8_t[]> data,
+                          std::size_t size);
+
+  const std::uint8_t *data() const { return data_.get(); }
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  std::span<const std::uint8_t> bytes() const { return {data_.get(), size_}; }
+
+  /**
+   * @brief Frees the buffer.
+   */
+  void reset() {
+    data_.reset();
+    size_ = 0;
+  }
+
+private:
+  std::unique_ptr<std::uint8_t[]> data_;
+  std::size_t size_ = 0;
+};
+
+/**
+ * @brief Asks the kernel to start reading a file in the background
+ * (POSIX_FADV_WILLNEED), so a later FileBuffer::read() hits the page cache.
+ */
+void prefetch_file(const std::filesystem::path &path);
+
+} // namespace importer
@@ -0,0 +1,52 @@
+/**
+ * SPDX-FileComment: File fingerprinting for incremental imports
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file file_fingerprint.hpp
+ * @brief stat()-based fingerprints and streaming content hashes
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <span>
+#include <string>
+
+namespace importer {
+
+/**
+ * @struct FileFingerprint
+ * @brief Cheap identity of a file as reported by stat().
+ */
+struct FileFingerprint {
+  std::int64_t size = 0;
+  std::int64_t mtime_ns = 0;
+  std::int64_t inode = 0;
+};
+
+/**
+ * @brief stat()s a file.
+ */
+std::expected<FileFingerprint, std::string>
+stat_fingerprint(const std::filesystem::path &path);
+
+/**
+ * @brief Content hash of a file's bytes: the first 256 bits of BLAKE2b-512
+ * as lowercase hex (truncated BLAKE2b-512, not BLAKE2b-256).
+ */
+std::expected<std::string, std::string>
+hash_bytes(std::span<const std::uint8_t> data);
+
+} // namespace importer
@@ -0,0 +1,361 @@
+/**
+ * SPDX-FileComment: Minimal JPEG/PNG/TIFF header reader implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file header_reader.cpp
+ * @brief Reads dimensions and the key EXIF fields without Exiv2/Magick
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "header_reader.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <format>
+#include <memory>
+#include <string_view>
+#include <unistd.h>
+#include <vector>
+
+namespace importer {
+
+namespace {
+
+using Bytes = std::span<const std::uint8_t>;
+
+std::uint16_t be16(const std::uint8_t *p) {
+  return static_cast<std::uint16_t>((p[0] << 8) | p[1]);
+}
+
+std::uint32_t be32(const std::uint8_t *p) {
+  return (std::uint32_t(p[0]) << 24) | (std::uint32_t(p[1]) << 16) |
+         (std::uint32_t(p[2]) << 8) | std::uint32_t(p[3]);
+}
+
+/**
+ * @brief Bounds-checked view of a TIFF structure (the Exif APP1 payload).
+ */
+class TiffReader {
+public:
+  explicit TiffReader(Bytes data) : data_(data) {}
+
+  bool init() {
+    if (data_.size() < 8)
+      return false;
+    if (data_[0] == 'I' && data_[1] == 'I')
+      little_ = true;
+    else if (data_[0] == 'M' && data_[1] == 'M')
+      little_ = false;
+    else
+      return false;
+    return u16(2) == 42;
+  }
+
+  std::uint32_t first_ifd() const { return u32(4); }
+
+  /// Calls fn(tag, type, count, value_offset) for each entry of an IFD.
+  template <typename Fn> void for_each_entry(std::uint32_t ifd, Fn fn) const {
+    if (!in_range(ifd, 2))
+      return;
+    const std::uint32_t count = u16(ifd);
+    for (std::uint32_t i = 0; i < count; ++i) {
+      const std::uint32_t entry = ifd + 2 + i * 12;
+      if (!in_range(entry, 12))
+        return;
+      const std::uint16_t type = u16(entry + 2);
+      const std::uint32_t n = u32(entry + 4);
+      const std::uint64_t size = std::uint64_t(type_size(type)) * n;
+      // Values of up to four bytes are stored in the entry itself.
+      const std::uint32_t offset = size <= 4 ? entry + 8 : u32(entry + 8);
+      if (size == 0 || !in_range(offset, size))
+        continue;
+      fn(u16(entry), type, n, offset);
+    }
+  }
+
+  std::string ascii(std::uint32_t offset, std::uint32_t count) const {
+    std::string s(reinterpret_cast<const char *>(data_.data() + offset),
+                  count);
+    // Counts include the NUL; cameras also pad with spaces.
+    while (!s.empty() && (s.back() == '\0' || s.back() == ' '))
+      s.pop_back();
+    if (auto nul = s.find('\0'); nul != std::string::npos)
+      s.resize(nul);
+    return s;
+  }
+
+  std::optional<double> rational(std::uint32_t offset) const {
+    const auto den = u32(offset + 4);
+    if (den == 0)
+      return std::nullopt;
+    return double(u32(offset)) / double(den);
+  }
+
+  std::uint32_t integer(std::uint16_t type, std::uint32_t offset) const {
+    switch (type) {
+    case 1:
+    case 7:
+      return data_[offset];
+    case 3:
+      return u16(offset);
+    case 4:
+    case 9:
+      return u32(offset);
+    default:
+      return 0;
+    }
+  }
+
+  std::uint16_t u16(std::uint32_t off) const {
+    const auto *p = data_.data() + off;
+    return little_ ? static_cast<std::uint16_t>(p[0] | (p[1] << 8)) : be16(p);
+  }
+
+  std::uint32_t u32(std::uint32_t off) const {
+    const auto *p = data_.data() + off;
+    return little_ ? (std::uint32_t(p[0]) | (std::uint32_t(p[1]) << 8) |
+                      (std::uint32_t(p[2]) << 16) | (std::uint32_t(p[3]) << 24))
+                   : be32(p);
+  }
+
+private:
+  static std::uint32_t type_size(std::uint16_t type) {
+    switch (type) {
+    case 1: // BYTE
+    case 2: // ASCII
+    case 6: // SBYTE
+    case 7: // UNDEFINED
+      return 1;
+    case 3: // SHORT
+    case 8: // SSHORT
+      return 2;
+    case 4:  // LONG
+    case 9:  // SLONG
+    case 11: // FLOAT
+      return 4;
+    case 5:  // RATIONAL
+    case 10: // SRATIONAL
+    case 12: // DOUBLE
+      return 8;
+    default:
+      return 0;
+    }
+  }
+
+  bool in_range(std::uint64_t offset, std::uint64_t size) const {
+    return offset + size <= data_.size();
+  }
+
+  Bytes data_;
+  bool little_ = true;
+};
+
+std::optional<double> gps_degrees(const TiffReader &tiff, std::uint16_t type,
+                                  std::uint32_t count, std::uint32_t offset) {
+  if (type != 5 || count < 3)
+    return std::nullopt;
+  auto d = tiff.rational(offset);
+  auto m = tiff.rational(offset + 8);
+  auto s = tiff.rational(offset + 16);
+  if (!d || !m || !s)
+    return std::nullopt;
+  return *d + *m / 60.0 + *s / 3600.0;
+}
+
+void parse_exif(Bytes tiff_data, HeaderInfo &info) {
+  TiffReader tiff(tiff_data);
+  if (!tiff.init())
+    return;
+
+  std::uint32_t exif_ifd = 0;
+  std::uint32_t gps_ifd = 0;
+  tiff.for_each_entry(tiff.first_ifd(), [&](auto tag, auto type, auto count,
+                                            auto offset) {
+    switch (tag) {
+    case 0x010F:
+      if (type == 2)
+        info.make = tiff.ascii(offset, count);
+      break;
+    case 0x0110:
+      if (type == 2)
+        info.model = tiff.ascii(offset, count);
+      break;
+    case 0x0112:
+      if (auto o = tiff.integer(type, offset); o >= 1 && o <= 8)
+        info.orientation = static_cast<int>(o);
+      break;
+    case 0x0132:
+      if (type == 2)
+        info.date_time = tiff.ascii(offset, count);
+      break;
+    case 0x8769:
+      exif_ifd = tiff.integer(type, offset);
+      break;
+    case 0x8825:
+      gps_ifd = tiff.integer(type, offset);
+      break;
+    }
+  });
+
+  if (exif_ifd != 0) {
+    tiff.for_each_entry(exif_ifd, [&](auto tag, auto type, auto count,
+                                      auto offset) {
+      if (tag == 0x9003 && type == 2)
+        info.date_time_original = tiff.ascii(offset, count);
+    });
+  }
+
+  if (gps_ifd != 0) {
+    char lat_ref = 'N', lon_ref = 'E';
+    bool below_sea_level = false;
+    tiff.for_each_entry(gps_ifd, [&](auto tag, auto type, auto count,
+                                     auto offset) {
+      switch (tag) {
+      case 1:
+        lat_ref = static_cast<char>(tiff_data[offset]);
+        break;
+      case 2:
+        info.gps_lat = gps_degrees(tiff, type, count, offset);
+        break;
+      case 3:
+        lon_ref = static_cast<char>(tiff_data[offset]);
+        break;
+      case 4:
+        info.gps_lon = gps_degrees(tiff, type, count, offset);
+        break;
+      case 5:
+        below_sea_level = tiff.integer(type, offset) == 1;
+        break;
+      case 6:
+        if (type == 5)
+          info.gps_alt = tiff.rational(offset);
+        break;
+      }
+    });
+    if (info.gps_lat && lat_ref == 'S')
+      *info.gps_lat = -*info.gps_lat;
+    if (info.gps_lon && lon_ref == 'W')
+      *info.gps_lon = -*info.gps_lon;
+    if (info.gps_alt && below_sea_level)
+      *info.gps_alt = -*info.gps_alt;
+  }
+}
+
+bool is_sof(std::uint8_t marker) {
+  // SOF0..SOF15 minus DHT (C4), JPG (C8) and DAC (CC).
+  return marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 &&
+         marker != 0xC8 && marker != 0xCC;
+}
+
+std::optional<HeaderInfo> parse_jpeg(Bytes data) {
+  HeaderInfo info;
+  info.format = "JPEG";
+
+  std::size_t pos = 2;
+  while (pos + 4 <= data.size()) {
+    if (data[pos] != 0xFF)
+      return std::nullopt;
+    const std::uint8_t marker = data[pos + 1];
+    if (marker == 0xFF) { // Fill byte.
+      ++pos;
+      continue;
+    }
+    if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7)) {
+      pos += 2;
+      continue;
+    }
+
+    const std::size_t length = be16(&data[pos + 2]);
+    if (length < 2 || pos + 2 + length > data.size())
+      return std::nullopt;
+    const auto segment = data.subspan(pos + 4, length - 2);
+
+    if (marker == 0xE1 && segment.size() > 6 &&
+        std::memcmp(segment.data(), "Exif\0\0", 6) == 0) {
+      parse_exif(segment.subspan(6), info);
+    } else if (is_sof(marker) && segment.size() >= 5) {
+      info.height = be16(&segment[1]);
+      info.width = be16(&segment[3]);
+      return info;
+    } else if (marker == 0xDA) {
+      break; // Entropy-coded data without a frame header.
+    }
+    pos += 2 + length;
+  }
+  return std::nullopt;
+}
+
+std::optional<HeaderInfo> parse_png(Bytes data) {
+  // Signature (8), IHDR length (4), "IHDR" (4), width (4), height (4).
+  if (data.size() < 24 || std::memcmp(&data[12], "IHDR", 4) != 0)
+    return std::nullopt;
+  HeaderInfo info;
+  info.format = "PNG";
+  info.width = static_cast<int>(be32(&data[16]));
+  info.height = static_cast<int>(be32(&data[20]));
+  return info;
+}
+
+} // namespace
+
+std::optional<HeaderInfo> parse_header(Bytes data) {
+  static constexpr std::uint8_t kPngSignature[] = {0x89, 'P',  'N',  'G',
+                                                   '\r', '\n', 0x1A, '\n'};
+  if (data.size() >= 2 && data[0] == 0xFF && data[1] == 0xD8)
+    return parse_jpeg(data);
+  if (data.size() >= 8 && std::memcmp(data.data(), kPngSignature, 8) == 0)
+    return parse_png(data);
+  return std::nullopt;
+}
+
+std::expected<HeaderInfo, std::string>
+read_header(const std::filesystem::path &path) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return std::unexpected(std::format("Could not open {}: {}", path.string(),
+                                       std::strerror(errno)));
+  std::unique_ptr<int, void (*)(int *)> guard(&fd, [](int *f) { ::close(*f); });
+
+  // The SOF marker normally sits within the first few dozen KB; large APP
+  // segments (XMP, ICC, maker notes) can push it further, so keep reading
+  // in growing steps while the header is incomplete.
+  constexpr std::size_t kFirstRead = 256 << 10;
+  std::vector<std::uint8_t> data;
+  for (std::size_t want = kFirstRead;; want *= 4) {
+    std::size_t have = data.size();
+    data.resize(want);
+    while (have < want) {
+      ssize_t n = ::pread(fd, data.data() + have, want - have,
+                          static_cast<off_t>(have));
+      if (n < 0 && errno == EINTR)
+        continue;
+      if (n < 0)
+        return std::unexpected(std::format("Could not read {}: {}",
+                                           path.string(),
+                                           std::strerror(errno)));
+      if (n == 0)
+        break;
+      have += static_cast<std::size_t>(n);
+    }
+    data.resize(have);
+    if (data.empty())
+      return std::unexpected(std::format("Empty file {}", path.string()));
+    if (auto info = parse_header(data))
+      return *info;
+    if (have < want) // End of file.
+      break;
+  }
+  return std::unexpected(
+      std::format("No JPEG/PNG header found in {}", path.string()));
+}
+
+} // namespace importer
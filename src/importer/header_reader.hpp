@@ -0,0 +1,71 @@
+/**
+ * SPDX-FileComment: Minimal JPEG/PNG/TIFF header reader
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file header_reader.hpp
+ * @brief Reads dimensions and the key EXIF fields without Exiv2/Magick
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+
+namespace importer {
+
+/**
+ * @struct HeaderInfo
+ * @brief What the importer needs from a file header.
+ *
+ * Strings are empty and optionals unset when the tag is absent. GPS values
+ * are signed decimal degrees / metres, as get_gps_coordinate() computes.
+ */
+struct HeaderInfo {
+  std::string format; ///< "JPEG" or "PNG" (ImageMagick coder names).
+  int width = 0;
+  int height = 0;
+  std::optional<int> orientation; ///< EXIF Orientation, 1..8.
+  std::string make;
+  std::string model;
+  std::string date_time;          ///< Exif.Image.DateTime
+  std::string date_time_original; ///< Exif.Photo.DateTimeOriginal
+  std::optional<double> gps_lat;
+  std::optional<double> gps_lon;
+  std::optional<double> gps_alt;
+};
+
+/**
+ * @brief Parses a JPEG (SOF + APP1/Exif) or PNG (IHDR) from memory.
+ *
+ * Parsing stops at the first SOF marker, so only the header region is
+ * touched. Malformed or truncated EXIF blocks are ignored field by field.
+ *
+ * @return std::nullopt if the data is not a JPEG/PNG or has no dimensions.
+ */
+std::optional<HeaderInfo> parse_header(std::span<const std::uint8_t> data);
+
+/**
+ * @brief Reads the start of a file with pread() and runs parse_header() on
+ * it.
+ *
+ * Reads 256 KiB first and more only if the header does not end there. A
+ * file truncated while it is read yields an error, not a SIGBUS.
+ */
+std::expected<HeaderInfo, std::string>
+read_header(const std::filesystem::path &path);
+
+} // namespace importer
@@ -0,0 +1,64 @@
+/**
+ * SPDX-FileComment: Image processing engine interface
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file image_engine.cpp
+ * @brief Engine selection
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "image_engine.hpp"
+#include "magick_engine.hpp"
+#include "vips_engine.hpp"
+#include <format>
+#include <stdexcept>
+
+namespace importer {
+
+std::optional<ImageEngineKind> parse_image_engine(std::string_view name) {
+  if (name == "magick")
+    return ImageEngineKind::Magick;
+  if (name == "vips")
+    return ImageEngineKind::Vips;
+  return std::nullopt;
+}
+
+std::string_view image_engine_name(ImageEngineKind kind) {
+  return kind == ImageEngineKind::Vips ? "vips" : "magick";
+}
+
+bool image_engine_available(ImageEngineKind kind) {
+#ifdef GALLERY_HAVE_VIPS
+  constexpr bool with_vips = true;
+#else
+  constexpr bool with_vips = false;
+#endif
+  return kind != ImageEngineKind::Vips || with_vips;
+}
+
+std::unique_ptr<IImageEngine> make_image_engine(ImageEngineKind kind) {
+  switch (kind) {
+  case ImageEngineKind::Magick:
+    return std::make_unique<MagickEngine>();
+  case ImageEngineKind::Vips:
+#ifdef GALLERY_HAVE_VIPS
+    return std::make_unique<VipsEngine>();
+#else
+    break;
+#endif
+  }
+  throw std::runtime_error(std::format(
+      "gallery-import was built without the {} engine",
+      image_engine_name(kind)));
+}
+
+} // namespace importer
@@ -0,0 +1,145 @@
+/**
+ * SPDX-FileComment: Image processing engine interface
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file image_engine.hpp
+ * @brief Decodes originals and renders the thumbnail ladder
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include "derivative_generator.hpp"
+#include "header_reader.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace importer {
+
+/**
+ * @enum ImageEngineKind
+ * @brief Library doing the pixel work.
+ */
+enum class ImageEngineKind {
+  Magick, ///< ImageMagick: the whole original in its pixel cache.
+  Vips    ///< libvips: demand-driven, decodes in strips with shrink-on-load.
+};
+
+/**
+ * @brief Parses "magick" / "vips".
+ */
+std::optional<ImageEngineKind> parse_image_engine(std::string_view name);
+
+/**
+ * @brief The name parse_image_engine() accepts.
+ */
+std::string_view image_engine_name(ImageEngineKind kind);
+
+/**
+ * @brief Whether this build includes the engine; libvips is optional.
+ */
+bool image_engine_available(ImageEngineKind kind);
+
+/**
+ * @struct ImageInfo
+ * @brief Dimensions and container format, known without decoding pixels.
+ */
+struct ImageInfo {
+  int width = 0;
+  int height = 0;
+  std::string format; ///< "JPEG", "PNG", ... like HeaderInfo::format.
+};
+
+/**
+ * @struct DecodeOptions
+ * @brief Shortcuts an engine may take while decoding.
+ */
+struct DecodeOptions {
+  /// Decode JPEGs at a reduced scale that still covers the largest size.
+  bool shrink_on_load = true;
+  /// Use an embedded camera preview that is large enough.
+  bool use_previews = true;
+};
+
+/**
+ * @class DecodedImage
+ * @brief Engine-specific state between decode() and render().
+ */
+class DecodedImage {
+public:
+  virtual ~DecodedImage() = default;
+
+  bool from_preview = false; ///< Decoded from an embedded preview.
+};
+
+/**
+ * @class IImageEngine
+ * @brief Turns encoded originals into box-fitted RGBA thumbnails.
+ *
+ * decode() runs in the read stage while the original's bytes are in memory;
+ * render() runs in the derivative stage, after the bytes are gone. Every
+ * method may be called concurrently for different photos and throws
+ * std::exception on failure.
+ */
+class IImageEngine {
+public:
+  virtual ~IImageEngine() = default;
+
+  virtual ImageEngineKind kind() const = 0;
+
+  /**
+   * @brief Reads dimensions and format from the container, for files the
+   * header reader does not understand.
+   */
+  virtual ImageInfo probe(std::span<const std::uint8_t> data) const = 0;
+
+  /**
+   * @param data The encoded original; need not outlive the result.
+   * @param info The original's dimensions and format.
+   * @param ladder Sizes render() will be asked for.
+   */
+  virtual std::unique_ptr<DecodedImage>
+  decode(std::span<const std::uint8_t> data, const ImageInfo &info,
+         const DerivativeGenerator &ladder,
+         const DecodeOptions &options) const = 0;
+
+  /**
+   * @param image Result of decode() for the same ladder; may be consumed.
+   * @return One thumbnail per ladder size, largest first.
+   */
+  virtual std::vector<Thumbnail>
+  render(DecodedImage &image, const DerivativeGenerator &ladder) const = 0;
+
+  /**
+   * @brief Upper bound of the memory a photo holds from decode() until
+   * render() has returned, including the encoded original.
+   * @param header Dimensions from the file header; std::nullopt if unknown.
+   */
+  virtual std::size_t estimate_memory(const std::optional<HeaderInfo> &header,
+                                      std::size_t file_size,
+                                      const DerivativeGenerator &ladder,
+                                      bool shrink_on_load) const = 0;
+};
+
+/**
+ * @brief Creates an engine; throws std::runtime_error if this build does
+ * not include it.
+ */
+std::unique_ptr<IImageEngine> make_image_engine(ImageEngineKind kind);
+
+} // namespace importer
@@ -0,0 +1,74 @@
+/**
+ * SPDX-FileComment: In-memory view of the import manifest
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file import_manifest.cpp
+ * @brief Thread-safe manifest cache used for incremental imports
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "import_manifest.hpp"
+#include <mutex>
+
+namespace importer {
+
+ImportManifest::ImportManifest(
+    domain::interfaces::IImportManifestRepository &repo)
+    : repo_(repo) {}
+
+std::expected<void, std::string> ImportManifest::load() {
+  auto rows = repo_.find_all();
+  if (!rows)
+    return std::unexpected(rows.error());
+
+  std::unique_lock lock(mutex_);
+  entries_.clear();
+  entries_.reserve(rows->size());
+  for (auto &entry : *rows) {
+    auto key = entry.file_path;
+    entries_.emplace(std::move(key), std::move(entry));
+  }
+  return {};
+}
+
+std::optional<domain::models::ManifestEntry>
+ImportManifest::find(const std::string &file_path) const {
+  std::shared_lock lock(mutex_);
+  auto it = entries_.find(file_path);
+  if (it == entries_.end())
+    return std::nullopt;
+  return it->second;
+}
+
+std::expected<void, std::string>
+ImportManifest::record(const domain::models::ManifestEntry &entry) {
+  if (auto res = repo_.upsert(entry); !res)
+    return res;
+  std::unique_lock lock(mutex_);
+  entries_.insert_or_assign(entry.file_path, entry);
+  return {};
+}
+
+void ImportManifest::forget(const std::string &path) {
+  const auto prefix = path + "/";
+  std::unique_lock lock(mutex_);
+  std::erase_if(entries_, [&](const auto &item) {
+    return item.first == path || item.first.starts_with(prefix);
+  });
+}
+
+std::size_t ImportManifest::size() const {
+  std::shared_lock lock(mutex_);
+  return entries_.size();
+}
+
+} // namespace importer
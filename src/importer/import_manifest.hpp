@@ -0,0 +1,71 @@
+/**
+ * SPDX-FileComment: In-memory view of the import manifest
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file import_manifest.hpp
+ * @brief Thread-safe manifest cache used for incremental imports
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include "domain/interfaces/i_import_manifest_repository.hpp"
+#include <expected>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace importer {
+
+/**
+ * @class ImportManifest
+ * @brief Keeps the whole manifest in memory so skip checks need no query.
+ *
+ * Loaded once at startup; record() writes through to the repository.
+ */
+class ImportManifest {
+public:
+  explicit ImportManifest(domain::interfaces::IImportManifestRepository &repo);
+
+  /**
+   * @brief Loads all manifest rows.
+   */
+  std::expected<void, std::string> load();
+
+  /**
+   * @brief Returns the recorded state of a file, if any.
+   */
+  std::optional<domain::models::ManifestEntry>
+  find(const std::string &file_path) const;
+
+  /**
+   * @brief Stores the state of a file.
+   */
+  std::expected<void, std::string>
+  record(const domain::models::ManifestEntry &entry);
+
+  /**
+   * @brief Drops cached entries for a removed file or directory. The rows
+   * themselves go away with their photo (ON DELETE CASCADE).
+   */
+  void forget(const std::string &path);
+
+  std::size_t size() const;
+
+private:
+  domain::interfaces::IImportManifestRepository &repo_;
+  mutable std::shared_mutex mutex_;
+  std::unordered_map<std::string, domain::models::ManifestEntry> entries_;
+};
+
+} // namespace importer
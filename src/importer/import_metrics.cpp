@@ -0,0 +1,140 @@
+/**
+ * SPDX-FileComment: Per-stage timing histograms for the importer implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file import_metrics.cpp
+ * @brief Lock-free latency histograms and the end-of-run summary table
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "import_metrics.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <format>
+#include <print>
+
+namespace importer {
+
+std::size_t LatencyHistogram::bucket_of(std::uint64_t us) {
+  if (us < 4)
+    return static_cast<std::size_t>(us);
+  const auto exp = static_cast<std::size_t>(std::bit_width(us) - 1);
+  const auto sub = static_cast<std::size_t>((us >> (exp - 2)) & 3);
+  return std::min(kBuckets - 1, 4 * (exp - 1) + sub);
+}
+
+std::uint64_t LatencyHistogram::bucket_upper(std::size_t index) {
+  ++index; // Upper bound = lower bound of the next bucket.
+  if (index < 4)
+    return index;
+  const std::size_t exp = index / 4 + 1;
+  return (4 + index % 4) << (exp - 2);
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds duration) {
+  const auto us = static_cast<std::uint64_t>(
+      std::max<std::int64_t>(0, duration.count() / 1000));
+  buckets_[bucket_of(us)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  total_us_.fetch_add(us, std::memory_order_relaxed);
+  auto prev = max_us_.load(std::memory_order_relaxed);
+  while (prev < us && !max_us_.compare_exchange_weak(prev, us))
+    ;
+}
+
+std::chrono::microseconds LatencyHistogram::total() const {
+  return std::chrono::microseconds(total_us_.load());
+}
+
+std::chrono::microseconds LatencyHistogram::max() const {
+  return std::chrono::microseconds(max_us_.load());
+}
+
+std::chrono::microseconds LatencyHistogram::mean() const {
+  const auto n = count();
+  return std::chrono::microseconds(n == 0 ? 0 : total_us_.load() / n);
+}
+
+std::chrono::microseconds LatencyHistogram::percentile(double quantile) const {
+  const auto n = count();
+  if (n == 0)
+    return std::chrono::microseconds(0);
+  const auto rank = static_cast<std::uint64_t>(
+      std::ceil(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(n)));
+  std::uint64_t seen = 0;
+  for (std::size_t i = 0; i < kBuckets; ++i) {
+    seen += buckets_[i].load(std::memory_order_relaxed);
+    if (seen >= rank && seen > 0)
+      return std::chrono::microseconds(
+          std::min<std::uint64_t>(bucket_upper(i), max_us_.load()));
+  }
+  return max();
+}
+
+void ImportMetrics::add_thumbnail_sizes(const std::vector<int> &sizes) {
+  for (int size : sizes) {
+    if (std::ranges::none_of(thumbnails_,
+                             [size](const auto &t) { return t.first == size; }))
+      thumbnails_.emplace_back(size, std::make_unique<LatencyHistogram>());
+  }
+}
+
+LatencyHistogram &ImportMetrics::stage(Stage stage) {
+  return stages_[static_cast<std::size_t>(stage)];
+}
+
+LatencyHistogram &ImportMetrics::thumbnail(int size) {
+  for (auto &[s, histogram] : thumbnails_) {
+    if (s == size)
+      return *histogram;
+  }
+  return unknown_size_;
+}
+
+namespace {
+std::string format_ms(std::chrono::microseconds us) {
+  return std::format("{:.1f}", static_cast<double>(us.count()) / 1000.0);
+}
+
+void print_row(std::FILE *out, const std::string &name,
+               const LatencyHistogram &h) {
+  if (h.count() == 0)
+    return;
+  std::println(out, "{:<12} {:>8} {:>9} {:>9} {:>9} {:>9} {:>9} {:>10}", name,
+               h.count(), format_ms(h.mean()), format_ms(h.percentile(0.50)),
+               format_ms(h.percentile(0.95)), format_ms(h.percentile(0.99)),
+               format_ms(h.max()),
+               std::format("{:.1f}",
+                           static_cast<double>(h.total().count()) / 1e6));
+}
+} // namespace
+
+void ImportMetrics::print_summary(std::FILE *out) const {
+  static constexpr const char *kStageNames[] = {
+      "read", "hash", "decode", "metadata", "resize", "db batch"};
+  std::println(out, "{:<12} {:>8} {:>9} {:>9} {:>9} {:>9} {:>9} {:>10}",
+               "stage", "count", "mean ms", "p50 ms", "p95 ms", "p99 ms",
+               "max ms", "total s");
+  for (std::size_t i = 0; i < stages_.size(); ++i) {
+    print_row(out, kStageNames[i], stages_[i]);
+    if (static_cast<Stage>(i) == Stage::Resize) {
+      for (const auto &[size, histogram] : thumbnails_)
+        print_row(out, std::format("webp {}", size), *histogram);
+    }
+  }
+  if (auto n = previews(); n > 0)
+    std::println(out, "{} photos rendered from their embedded preview "
+                      "without a full decode.", n);
+}
+
+} // namespace importer
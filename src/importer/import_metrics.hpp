@@ -0,0 +1,127 @@
+/**
+ * SPDX-FileComment: Per-stage timing histograms for the importer
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file import_metrics.hpp
+ * @brief Lock-free latency histograms and the end-of-run summary table
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace importer {
+
+/**
+ * @class LatencyHistogram
+ * @brief Log-linear histogram of durations, safe to record from any thread.
+ *
+ * Every power of two (in microseconds) is split into four buckets, so
+ * percentiles are accurate to within 25% at any scale.
+ */
+class LatencyHistogram {
+public:
+  void record(std::chrono::nanoseconds duration);
+
+  std::uint64_t count() const { return count_.load(); }
+  std::chrono::microseconds total() const;
+  std::chrono::microseconds max() const;
+  std::chrono::microseconds mean() const;
+  /**
+   * @brief Upper bound of the bucket holding the given quantile (0..1).
+   */
+  std::chrono::microseconds percentile(double quantile) const;
+
+private:
+  static constexpr std::size_t kBuckets = 160;
+  static std::size_t bucket_of(std::uint64_t us);
+  static std::uint64_t bucket_upper(std::size_t index);
+
+  std::array<std::atomic<std::uint64_t>, kBuckets> buckets_{};
+  std::atomic<std::uint64_t> count_{0};
+  std::atomic<std::uint64_t> total_us_{0};
+  std::atomic<std::uint64_t> max_us_{0};
+};
+
+/**
+ * @enum Stage
+ * @brief Import steps that are timed per photo (Persist: per batch).
+ */
+enum class Stage { Read, Hash, Decode, Metadata, Resize, Persist };
+
+/**
+ * @class ImportMetrics
+ * @brief One histogram per stage plus one per thumbnail size (encode+write).
+ */
+class ImportMetrics {
+public:
+  /**
+   * @brief Adds histograms for thumbnail sizes. Not thread-safe; call before
+   * recording starts.
+   */
+  void add_thumbnail_sizes(const std::vector<int> &sizes);
+
+  LatencyHistogram &stage(Stage stage);
+  /// Histogram for encoding and writing one thumbnail size.
+  LatencyHistogram &thumbnail(int size);
+
+  /// Counts a photo whose thumbnails came from its embedded preview alone.
+  void count_preview() { previews_.fetch_add(1, std::memory_order_relaxed); }
+  std::uint64_t previews() const { return previews_.load(); }
+
+  /**
+   * @brief Prints the per-stage table (count, mean, p50, p95, p99, max and
+   * total time).
+   */
+  void print_summary(std::FILE *out) const;
+
+private:
+  std::array<LatencyHistogram, 6> stages_;
+  std::vector<std::pair<int, std::unique_ptr<LatencyHistogram>>> thumbnails_;
+  LatencyHistogram unknown_size_;
+  std::atomic<std::uint64_t> previews_{0};
+};
+
+/**
+ * @class StageTimer
+ * @brief Records the lifetime of the scope into a histogram; a null
+ * histogram makes it a no-op.
+ */
+class StageTimer {
+public:
+  explicit StageTimer(LatencyHistogram *histogram)
+      : histogram_(histogram),
+        start_(histogram ? std::chrono::steady_clock::now()
+                         : std::chrono::steady_clock::time_point{}) {}
+  ~StageTimer() {
+    if (histogram_)
+      histogram_->record(std::chrono::steady_clock::now() - start_);
+  }
+
+  StageTimer(const StageTimer &) = delete;
+  StageTimer &operator=(const StageTimer &) = delete;
+
+private:
+  LatencyHistogram *histogram_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace importer
@@ -0,0 +1,491 @@
+/**
+ * SPDX-FileComment: Command line options of gallery-import
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file import_options.cpp
+ * @brief Parsing of the gallery-import command line
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "import_options.hpp"
+#include "archive_reader.hpp"
+#include "core/config/config_loader.hpp"
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <format>
+#include <print>
+#include <ranges>
+#include <string_view>
+
+namespace importer {
+
+static std::expected<std::size_t, std::string>
+parse_count(std::string_view flag, std::string_view value) {
+  std::size_t n = 0;
+  auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), n);
+  if (ec != std::errc() || ptr != value.data() + value.size()) {
+    return std::unexpected(
+        std::format("Invalid value for {}: '{}'", flag, value));
+  }
+  return n;
+}
+
+// Accepts a plain byte count or a number with a K, M, G or T suffix
+// (powers of 1024), e.g. "512M" or "4G".
+static std::expected<std::size_t, std::string>
+parse_byte_size(std::string_view flag, std::string_view value) {
+  constexpr std::string_view kSuffixes = "KMGT";
+  std::size_t shift = 0;
+  if (!value.empty()) {
+    const auto unit = static_cast<char>(
+        std::toupper(static_cast<unsigned char>(value.back())));
+    if (auto pos = kSuffixes.find(unit); pos != std::string_view::npos)
+      shift = 10 * (pos + 1);
+  }
+  auto digits = shift > 0 ? value.substr(0, value.size() - 1) : value;
+  auto n = parse_count(flag, digits);
+  if (!n || *n == 0 || *n > (SIZE_MAX >> shift))
+    return std::unexpected(
+        std::format("Invalid value for {}: '{}'", flag, value));
+  return *n << shift;
+}
+
+// Comma-separated box sizes, e.g. "480,800,1600". The ladder must not be
+// empty: the pipeline renders the largest size first and derives the
+// placeholder from the smallest.
+static std::expected<std::vector<int>, std::string>
+parse_size_list(std::string_view flag, std::string_view value) {
+  constexpr std::size_t kMaxSize = 16384;
+  std::vector<int> sizes;
+  for (auto part : std::views::split(value, ',')) {
+    // An empty part ("480,,800", "480,") fails to parse as well.
+    auto n = parse_count(flag, std::string_view(part.begin(), part.end()));
+    if (!n || *n == 0 || *n > kMaxSize)
+      return std::unexpected(
+          std::format("Invalid value for {}: '{}'", flag, value));
+    sizes.push_back(static_cast<int>(*n));
+  }
+  if (sizes.empty())
+    return std::unexpected(std::format("{} needs at least one size", flag));
+  return sizes;
+}
+
+static std::expected<float, std::string> parse_quality(std::string_view flag,
+                                                       std::string_view value) {
+  auto quality = parse_count(flag, value);
+  if (!quality || *quality > 100)
+    return std::unexpected(
+        std::format("Invalid value for {}: '{}'", flag, value));
+  return static_cast<float>(*quality);
+}
+
+static std::expected<int, std::string> parse_method(std::string_view flag,
+                                                    std::string_view value) {
+  auto method = parse_count(flag, value);
+  if (!method || *method > 6)
+    return std::unexpected(
+        std::format("Invalid value for {}: '{}'", flag, value));
+  return static_cast<int>(*method);
+}
+
+// The thumbnail tree is shared with the backend, so its layout and the
+// encoder settings live in .env; command-line flags override them.
+static std::expected<void, std::string> apply_config(ImportOptions &opts) {
+  using core::config::ConfigLoader;
+  if (auto value = ConfigLoader::get("THUMB_ROOT"); !value.empty())
+    opts.thumb_root = value;
+  if (auto value = ConfigLoader::get("THUMB_SIZES"); !value.empty()) {
+    auto sizes = parse_size_list("THUMB_SIZES", value);
+    if (!sizes)
+      return std::unexpected(sizes.error());
+    opts.thumb_sizes = std::move(*sizes);
+  }
+  if (auto value = ConfigLoader::get("THUMB_STORE"); !value.empty()) {
+    auto store = parse_thumb_store(value);
+    if (!store)
+      return std::unexpected(
+          std::format("Invalid THUMB_STORE '{}' (files|packs)", value));
+    opts.thumb_store = *store;
+  }
+  if (auto value = ConfigLoader::get("IMAGE_ENGINE"); !value.empty()) {
+    auto engine = parse_image_engine(value);
+    if (!engine)
+      return std::unexpected(
+          std::format("Invalid IMAGE_ENGINE '{}' (magick|vips)", value));
+    opts.engine = *engine;
+  }
+  if (auto value = ConfigLoader::get("THUMB_ENCODER"); !value.empty()) {
+    auto backend = parse_encoder_backend(value);
+    if (!backend)
+      return std::unexpected(
+          std::format("Invalid THUMB_ENCODER '{}' (libwebp|magick)", value));
+    opts.encoder = *backend;
+  }
+  if (auto value = ConfigLoader::get("THUMB_QUALITY"); !value.empty()) {
+    auto quality = parse_quality("THUMB_QUALITY", value);
+    if (!quality)
+      return std::unexpected(quality.error());
+    opts.webp.quality = *quality;
+  }
+  if (auto value = ConfigLoader::get("THUMB_METHOD"); !value.empty()) {
+    auto method = parse_method("THUMB_METHOD", value);
+    if (!method)
+      return std::unexpected(method.error());
+    opts.webp.method = *method;
+  }
+  return {};
+}
+
+std::expected<ImportOptions, std::string> parse_import_options(int argc,
+                                                                char **argv) {
+  ImportOptions opts;
+  if (auto res = apply_config(opts); !res)
+    return std::unexpected(res.error());
+
+  int first = 1;
+  if (argc > 1) {
+    std::string_view command = argv[1];
+    if (command == "duplicates")
+      opts.command = ImportCommand::Duplicates;
+    else if (command == "enqueue")
+      opts.command = ImportCommand::Enqueue;
+    else if (command == "worker")
+      opts.command = ImportCommand::Worker;
+    else if (command == "reconcile")
+      opts.command = ImportCommand::Reconcile;
+    else if (command == "regenerate")
+      opts.command = ImportCommand::Regenerate;
+    if (opts.command != ImportCommand::Import)
+      first = 2;
+  }
+
+  for (int i = first; i < argc; ++i) {
+    std::string_view arg = argv[i];
+
+    // Accepts both "--flag value" and "--flag=value".
+    auto value_of = [&](std::string_view flag)
+        -> std::expected<std::string_view, std::string> {
+      if (arg.size() > flag.size() && arg[flag.size()] == '=')
+        return arg.substr(flag.size() + 1);
+      if (i + 1 >= argc)
+        return std::unexpected(std::format("Missing value for {}", flag));
+      return std::string_view(argv[++i]);
+    };
+    auto is_flag = [&](std::string_view flag) {
+      return arg == flag ||
+             (arg.starts_with(flag) && arg.size() > flag.size() &&
+              arg[flag.size()] == '=');
+    };
+
+    if (is_flag("--jobs") || is_flag("-j")) {
+      auto value = value_of(arg.starts_with("--") ? "--jobs" : "-j");
+      if (!value)
+        return std::unexpected(value.error());
+      auto jobs = parse_count("--jobs", *value);
+      if (!jobs)
+        return std::unexpected(jobs.error());
+      opts.jobs = *jobs;
+    } else if (is_flag("--batch-size")) {
+      auto value = value_of("--batch-size");
+      if (!value)
+        return std::unexpected(value.error());
+      auto size = parse_count("--batch-size", *value);
+      if (!size || *size == 0)
+        return std::unexpected(
+            std::format("Invalid value for --batch-size: '{}'", *value));
+      opts.batch_size = *size;
+    } else if (is_flag("--max-decode-mem")) {
+      auto value = value_of("--max-decode-mem");
+      if (!value)
+        return std::unexpected(value.error());
+      auto bytes = parse_byte_size("--max-decode-mem", *value);
+      if (!bytes)
+        return std::unexpected(bytes.error());
+      opts.max_decode_mem = *bytes;
+    } else if (is_flag("--thumb-mode")) {
+      auto value = value_of("--thumb-mode");
+      if (!value)
+        return std::unexpected(value.error());
+      auto mode = parse_resize_mode(*value);
+      if (!mode)
+        return std::unexpected(std::format(
+            "Invalid --thumb-mode '{}' (cascade|independent)", *value));
+      opts.resize_mode = *mode;
+    } else if (is_flag("--thumb-sizes")) {
+      auto value = value_of("--thumb-sizes");
+      if (!value)
+        return std::unexpected(value.error());
+      auto sizes = parse_size_list("--thumb-sizes", *value);
+      if (!sizes)
+        return std::unexpected(sizes.error());
+      opts.thumb_sizes = std::move(*sizes);
+    } else if (is_flag("--archive")) {
+      auto value = value_of("--archive");
+      if (!value)
+        return std::unexpected(value.error());
+      opts.archives.emplace_back(*value);
+    } else if (is_flag("--thumb-root")) {
+      auto value = value_of("--thumb-root");
+      if (!value)
+        return std::unexpected(value.error());
+      opts.thumb_root = *value;
+    } else if (is_flag("--thumb-store")) {
+      auto value = value_of("--thumb-store");
+      if (!value)
+        return std::unexpected(value.error());
+      auto store = parse_thumb_store(*value);
+      if (!store)
+        return std::unexpected(
+            std::format("Invalid --thumb-store '{}' (files|packs)", *value));
+      opts.thumb_store = *store;
+    } else if (is_flag("--metadata")) {
+      auto value = value_of("--metadata");
+      if (!value)
+        return std::unexpected(value.error());
+      if (*value == "full")
+        opts.full_metadata = true;
+      else if (*value == "fast")
+        opts.full_metadata = false;
+      else
+        return std::unexpected(
+            std::format("Invalid --metadata '{}' (full|fast)", *value));
+    } else if (is_flag("--engine")) {
+      auto value = value_of("--engine");
+      if (!value)
+        return std::unexpected(value.error());
+      auto engine = parse_image_engine(*value);
+      if (!engine)
+        return std::unexpected(
+            std::format("Invalid --engine '{}' (magick|vips)", *value));
+      opts.engine = *engine;
+    } else if (is_flag("--encoder")) {
+      auto value = value_of("--encoder");
+      if (!value)
+        return std::unexpected(value.error());
+      auto backend = parse_encoder_backend(*value);
+      if (!backend)
+        return std::unexpected(
+            std::format("Invalid --encoder '{}' (libwebp|magick)", *value));
+      opts.encoder = *backend;
+    } else if (is_flag("--webp-quality")) {
+      auto value = value_of("--webp-quality");
+      if (!value)
+        return std::unexpected(value.error());
+      auto quality = parse_quality("--webp-quality", *value);
+      if (!quality)
+        return std::unexpected(quality.error());
+      opts.webp.quality = *quality;
+    } else if (is_flag("--webp-method")) {
+      auto value = value_of("--webp-method");
+      if (!value)
+        return std::unexpected(value.error());
+      auto method = parse_method("--webp-method", *value);
+      if (!method)
+        return std::unexpected(method.error());
+      opts.webp.method = *method;
+    } else if (arg == "--webp-threads") {
+      opts.webp.multithreaded = true;
+    } else if (arg == "--watch") {
+      opts.watch = true;
+    } else if (is_flag("--settle-ms")) {
+      auto value = value_of("--settle-ms");
+      if (!value)
+        return std::unexpected(value.error());
+      auto ms = parse_count("--settle-ms", *value);
+      if (!ms)
+        return std::unexpected(ms.error());
+      opts.settle_ms = *ms;
+    } else if (is_flag("--progress-json")) {
+      auto value = value_of("--progress-json");
+      if (!value)
+        return std::unexpected(value.error());
+      opts.progress_json = std::string(*value);
+    } else if (is_flag("--progress-interval")) {
+      auto value = value_of("--progress-interval");
+      if (!value)
+        return std::unexpected(value.error());
+      auto seconds = parse_count("--progress-interval", *value);
+      if (!seconds || *seconds == 0)
+        return std::unexpected(
+            std::format("Invalid value for --progress-interval: '{}'", *value));
+      opts.progress_interval_s = *seconds;
+    } else if (is_flag("--lease-seconds")) {
+      auto value = value_of("--lease-seconds");
+      if (!value)
+        return std::unexpected(value.error());
+      auto seconds = parse_count("--lease-seconds", *value);
+      if (!seconds || *seconds < 3)
+        return std::unexpected(
+            std::format("Invalid value for --lease-seconds: '{}'", *value));
+      opts.lease_s = *seconds;
+    } else if (arg == "--dry-run") {
+      opts.dry_run = true;
+    } else if (arg == "--incremental") {
+      opts.incremental = true;
+    } else if (arg == "--metadata-only") {
+      opts.metadata_only = true;
+    } else if (arg == "--no-shrink-on-load") {
+      opts.shrink_on_load = false;
+    } else if (arg == "--no-previews") {
+      opts.use_previews = false;
+    } else if (arg.starts_with("-")) {
+      return std::unexpected(std::format("Unknown option: {}", arg));
+    } else if (opts.root.empty()) {
+      opts.root = arg;
+    } else {
+      return std::unexpected(std::format("Unexpected argument: {}", arg));
+    }
+  }
+
+  const bool needs_root = opts.command == ImportCommand::Import ||
+                          opts.command == ImportCommand::Enqueue ||
+                          opts.command == ImportCommand::Reconcile ||
+                          opts.command == ImportCommand::Regenerate;
+  if (needs_root && opts.root.empty())
+    return std::unexpected("Missing <directory>");
+  if (opts.command == ImportCommand::Worker && opts.watch)
+    return std::unexpected("--watch cannot be combined with worker");
+  if (!image_engine_available(opts.engine))
+    return std::unexpected(
+        std::format("This build does not include the {} engine",
+                    image_engine_name(opts.engine)));
+  if (!opts.archives.empty() && !archive_import_available())
+    return std::unexpected("This build does not include archive import");
+  if (!opts.archives.empty() &&
+      (opts.command != ImportCommand::Import || opts.watch ||
+       opts.metadata_only))
+    return std::unexpected("--archive is a plain import: it cannot be "
+                           "combined with --watch, --metadata-only or a "
+                           "subcommand");
+  if (opts.metadata_only && (opts.command != ImportCommand::Import ||
+                             opts.incremental || opts.watch))
+    return std::unexpected("--metadata-only is a plain import: it cannot be "
+                           "combined with --incremental, --watch or a "
+                           "subcommand");
+  if (opts.dry_run && opts.command != ImportCommand::Reconcile &&
+      opts.command != ImportCommand::Regenerate)
+    return std::unexpected("--dry-run works only with reconcile or "
+                           "regenerate");
+  return opts;
+}
+
+void print_usage() {
+  std::println("Usage: gallery-import [options] <directory>");
+  std::println("       gallery-import duplicates");
+  std::println("       gallery-import enqueue <directory>");
+  std::println("       gallery-import worker [options]");
+  std::println("       gallery-import reconcile [--dry-run] [options] "
+               "<directory>");
+  std::println("       gallery-import regenerate [--dry-run] [options] "
+               "<directory>");
+  std::println("");
+  std::println("  -j, --jobs N          Worker threads for decode/encode "
+               "(default: one per core)");
+  std::println("  --batch-size N        Photos stored per database "
+               "transaction (default: 32)");
+  std::println("  --max-decode-mem SIZE Memory budget for photos being "
+               "decoded, e.g. 4G;");
+  std::println("                        larger photos wait, photos that can "
+               "never fit fail");
+  std::println("  --thumb-mode MODE     cascade (default): resize the original "
+               "once, then each");
+  std::println("                        smaller size from the previous one;");
+  std::println("                        independent: resize every size from "
+               "the original");
+  std::println("  --thumb-sizes LIST    Comma-separated thumbnail box sizes "
+               "(THUMB_SIZES,");
+  std::println("                        default: 480,680,800,1024,1280)");
+  std::println("  --thumb-root DIR      Thumbnail tree (THUMB_ROOT, default: "
+               "/data/thumbs)");
+  std::println("  --thumb-store STORE   files (default): one WebP file per "
+               "photo and size;");
+  std::println("                        packs: append to one pack file per "
+               "directory and size");
+  std::println("                        (THUMB_STORE)");
+  std::println("  --archive FILE        Unpack the photos of a ZIP/TAR archive "
+               "(.gz/.bz2/.xz/.zst)");
+  std::println("                        into <directory> and import them "
+               "instead of scanning;");
+  std::println("                        may be repeated");
+  std::println("  --incremental         Skip files whose size, mtime, inode or "
+               "content hash");
+  std::println("                        match the import manifest");
+  std::println("  --metadata-only       Rewrite metadata and tags of photos "
+               "already stored;");
+  std::println("                        no decoding, thumbnails stay as they "
+               "are");
+  std::println("  --no-shrink-on-load   Decode JPEGs at full resolution "
+               "instead of letting");
+  std::println("                        libjpeg downscale to the largest "
+               "thumbnail size");
+  std::println("  --no-previews         Always decode the main image instead of "
+               "rendering");
+  std::println("                        thumbnails from an embedded preview");
+  std::println("  --metadata MODE       full (default): store every "
+               "EXIF/IPTC/XMP tag via Exiv2;");
+  std::println("                        fast: read only camera, dates, "
+               "orientation and GPS");
+  std::println("                        from the JPEG header");
+  std::println("  --engine NAME         Decode/resize engine: magick (default) "
+               "or vips, which");
+  std::println("                        streams and shrinks on load with far "
+               "less memory");
+  std::println("                        (IMAGE_ENGINE)");
+  std::println("  --encoder NAME        WebP backend: libwebp (default) or "
+               "magick (THUMB_ENCODER)");
+  std::println("  --webp-quality Q      WebP quality 0-100 (THUMB_QUALITY, "
+               "default: 75)");
+  std::println("  --webp-method M       WebP effort 0 (fast) - 6 (small), "
+               "default: 4 (THUMB_METHOD)");
+  std::println("  --webp-threads        Let libwebp use a second thread per "
+               "image");
+  std::println("  --watch               After the initial scan, keep importing "
+               "new, changed and");
+  std::println("                        deleted files (inotify) until "
+               "stopped");
+  std::println("  --settle-ms MS        Time a watched file must stay "
+               "unchanged before import");
+  std::println("                        (default: 2000)");
+  std::println("  --progress-json FILE  Append a JSON progress line (rate, ETA, "
+               "queue depths)");
+  std::println("                        to FILE every interval; '-' writes "
+               "to stdout and");
+  std::println("                        suppresses the per-file lines");
+  std::println("  --progress-interval S Seconds between progress lines "
+               "(default: 5)");
+  std::println("  --lease-seconds S     worker: seconds a claimed job stays "
+               "reserved without");
+  std::println("                        a heartbeat (default: 300)");
+  std::println("  --dry-run             reconcile, regenerate: report "
+               "differences without");
+  std::println("                        changing anything");
+  std::println("");
+  std::println("  duplicates            List groups of byte-identical "
+               "originals");
+  std::println("  enqueue               Add the photos below <directory> to "
+               "the import queue");
+  std::println("  worker                Import queued photos; run any number "
+               "of these on any");
+  std::println("                        host sharing the database and "
+               "storage");
+  std::println("  reconcile             Delete rows and thumbnails of removed "
+               "originals, import");
+  std::println("                        new files and render missing "
+               "thumbnail sizes");
+  std::println("  regenerate            Render only the thumbnail sizes "
+               "missing from the ladder,");
+  std::println("                        from the smallest existing size "
+               "that covers them");
+}
+
+} // namespace importer
@@ -0,0 +1,93 @@
+/**
+ * SPDX-FileComment: Command line options of gallery-import
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file import_options.hpp
+ * @brief Parsing of the gallery-import command line
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include "derivative_generator.hpp"
+#include "image_engine.hpp"
+#include "thumb_pack.hpp"
+#include "webp_encoder.hpp"
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace importer {
+
+/**
+ * @enum ImportCommand
+ * @brief What gallery-import should do.
+ */
+enum class ImportCommand {
+  Import,     ///< Import the photos below root (default).
+  Duplicates, ///< Report byte-identical originals already in the database.
+  Enqueue,    ///< Queue the photos below root for distributed workers.
+  Worker,     ///< Import queued photos until the queue is drained.
+  Reconcile,  ///< Sync rows and thumbnails with the files below root.
+  Regenerate  ///< Render thumbnail sizes missing from the ladder.
+};
+
+/**
+ * @struct ImportOptions
+ * @brief Settings collected from the gallery-import command line.
+ */
+struct ImportOptions {
+  ImportCommand command = ImportCommand::Import;
+  std::filesystem::path root; ///< Library directory to import.
+  /// ZIP/TAR archives to unpack into root and import instead of scanning.
+  std::vector<std::filesystem::path> archives;
+  std::size_t jobs = 0;       ///< Worker threads; 0 = one per core.
+  std::size_t batch_size = 32; ///< Photos per DB transaction.
+  std::size_t max_decode_mem = 0; ///< Decode memory budget; 0 = unlimited.
+  std::vector<int> thumb_sizes = {480, 680, 800, 1024, 1280}; ///< Ladder.
+  std::filesystem::path thumb_root = "/data/thumbs"; ///< Thumbnail tree.
+  ResizeMode resize_mode = ResizeMode::Cascade; ///< Thumbnail resize strategy.
+  ThumbStore thumb_store = ThumbStore::Files; ///< Thumbnail storage backend.
+  bool incremental = false; ///< Skip files unchanged since the last import.
+  bool metadata_only = false; ///< Re-extract metadata of stored photos only.
+  bool shrink_on_load = true; ///< Scaled JPEG decoding for thumbnails.
+  bool use_previews = true; ///< Thumbnails from embedded camera previews.
+  bool full_metadata = true; ///< Exiv2 capture instead of the header reader.
+  ImageEngineKind engine = ImageEngineKind::Magick; ///< Decode/resize.
+  EncoderBackend encoder = EncoderBackend::LibWebP; ///< WebP backend.
+  WebpSettings webp; ///< WebP quality/effort/threading.
+  bool watch = false; ///< Keep running and import changes as they happen.
+  std::size_t settle_ms = 2000; ///< Quiet period before a new file is read.
+  std::string progress_json; ///< JSON progress target ("-" = stdout).
+  std::size_t progress_interval_s = 5; ///< Seconds between progress lines.
+  std::size_t lease_s = 300; ///< Queue lease of a claimed job (worker).
+  bool dry_run = false; ///< reconcile, regenerate: only report.
+};
+
+/**
+ * @brief Parses the command line. Thumbnail settings start from the
+ * configuration (THUMB_ROOT, THUMB_SIZES, THUMB_STORE, IMAGE_ENGINE,
+ * THUMB_ENCODER, THUMB_QUALITY, THUMB_METHOD), so ConfigLoader must be
+ * loaded first; flags override them.
+ * @return ImportOptions or an error message suitable for the user.
+ */
+std::expected<ImportOptions, std::string> parse_import_options(int argc,
+                                                                char **argv);
+
+/**
+ * @brief Prints the usage text to stdout.
+ */
+void print_usage();
+
+} // namespace importer
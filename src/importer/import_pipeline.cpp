@@ -0,0 +1,267 @@
+/**
+ * SPDX-FileComment: Staged parallel import pipeline implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file import_pipeline.cpp
+ * @brief scan -> read -> metadata -> derivatives -> persist pipeline
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "import_pipeline.hpp"
+#include <cstddef>
+#include <deque>
+#include <format>
+#include <print>
+#include <utility>
+
+namespace importer {
+
+static PipelineOptions normalized(PipelineOptions options) {
+  if (options.jobs == 0)
+    options.jobs = WorkStealingPool::default_size();
+  if (options.max_in_flight == 0)
+    options.max_in_flight = options.jobs * 2;
+  if (options.persist_workers == 0)
+    options.persist_workers = 1;
+  if (options.prefetch_depth == 0)
+    options.prefetch_depth = options.jobs;
+  return options;
+}
+
+ImportPipeline::ImportPipeline(PhotoProcessor &processor,
+                               PipelineOptions options)
+    : processor_(processor), options_(normalized(options)),
+      scan_queue_(options_.scan_queue_capacity),
+      persist_queue_(options_.persist_queue_capacity),
+      slots_(static_cast<std::ptrdiff_t>(options_.max_in_flight)),
+      memory_(options_.max_decode_mem > 0
+                  ? std::make_unique<MemoryBudget>(options_.max_decode_mem)
+                  : nullptr),
+      pool_(options_.jobs, &PhotoProcessor::init_worker_thread) {
+  dispatcher_ = std::thread([this] { dispatch_loop(); });
+  for (std::size_t i = 0; i < options_.persist_workers; ++i)
+    persisters_.emplace_back([this] { persist_loop(); });
+}
+
+ImportPipeline::~ImportPipeline() { finish(); }
+
+bool ImportPipeline::submit(const std::filesystem::path &base_path,
+                            const std::filesystem::path &file_path,
+                            std::optional<std::int64_t> queue_id) {
+  auto job = std::make_shared<PhotoJob>();
+  job->base_path = base_path;
+  job->file_path = file_path;
+  job->queue_id = queue_id;
+  if (!scan_queue_.push(std::move(job)))
+    return false;
+  stats_.submitted.fetch_add(1);
+  return true;
+}
+
+bool ImportPipeline::submit(const std::filesystem::path &base_path,
+                            const std::filesystem::path &file_path,
+                            FileBuffer source) {
+  auto job = std::make_shared<PhotoJob>();
+  job->base_path = base_path;
+  job->file_path = file_path;
+  job->source = std::move(source);
+  if (!scan_queue_.push(std::move(job)))
+    return false;
+  stats_.submitted.fetch_add(1);
+  return true;
+}
+
+void ImportPipeline::finish() {
+  if (finished_)
+    return;
+  finished_ = true;
+
+  scan_queue_.close();
+  if (dispatcher_.joinable())
+    dispatcher_.join();
+  pool_.wait_idle();
+  persist_queue_.close();
+  for (auto &t : persisters_) {
+    if (t.joinable())
+      t.join();
+  }
+}
+
+void ImportPipeline::dispatch_loop() {
+  // Files waiting for a slot; the kernel is already reading them in.
+  std::deque<JobPtr> lookahead;
+  for (;;) {
+    while (lookahead.size() < options_.prefetch_depth) {
+      auto next = lookahead.empty() ? scan_queue_.pop() : scan_queue_.try_pop();
+      if (!next)
+        break;
+      if (options_.prefetch_files && (*next)->source.empty())
+        prefetch_file((*next)->file_path);
+      lookahead.push_back(std::move(*next));
+    }
+    if (lookahead.empty())
+      return; // Closed and drained.
+
+    slots_.acquire();
+    in_flight_.fetch_add(1);
+    // Blocking here rather than in a pool task keeps the workers free to
+    // finish the photos that will give the memory back.
+    if (memory_)
+      reserve_memory(*lookahead.front());
+    pool_.submit([this, job = std::move(lookahead.front())] { run_read(job); });
+    lookahead.pop_front();
+  }
+}
+
+void ImportPipeline::reserve_memory(PhotoJob &job) {
+  std::size_t file_size = job.source.size();
+  std::optional<HeaderInfo> header;
+  if (!job.source.empty()) {
+    header = parse_header(job.source.bytes());
+  } else {
+    std::error_code ec;
+    file_size =
+        static_cast<std::size_t>(std::filesystem::file_size(job.file_path, ec));
+    if (ec)
+      return; // The read stage reports the error.
+    if (auto parsed = read_header(job.file_path))
+      header = std::move(*parsed);
+  }
+  const auto bytes = processor_.estimate_memory(header, file_size);
+
+  if (!memory_->acquire(bytes)) {
+    job.over_budget = std::format(
+        "needs about {} MiB to decode, the memory budget is {} MiB",
+        bytes >> 20, memory_->capacity() >> 20);
+    return;
+  }
+  job.reserved_bytes = bytes;
+}
+
+void ImportPipeline::release_memory(PhotoJob &job) {
+  if (memory_)
+    memory_->release(std::exchange(job.reserved_bytes, 0));
+}
+
+void ImportPipeline::run_read(JobPtr job) {
+  try {
+    bool proceed = processor_.read(*job);
+    if (!job->source.empty()) {
+      stats_.files_read.fetch_add(1);
+      stats_.bytes_read.fetch_add(job->source.size());
+    }
+    if (!proceed) {
+      stats_.skipped.fetch_add(1);
+      release_slot(*job, nullptr);
+      return;
+    }
+  } catch (const std::exception &e) {
+    return fail(*job, e.what());
+  }
+  pool_.submit([this, job] { run_metadata(job); });
+}
+
+void ImportPipeline::run_metadata(JobPtr job) {
+  try {
+    processor_.extract_metadata(*job);
+  } catch (const std::exception &e) {
+    return fail(*job, e.what());
+  }
+  // Decoded and parsed; the encoded bytes are no longer needed.
+  job->source.reset();
+  pool_.submit([this, job] { run_derivatives(job); });
+}
+
+void ImportPipeline::run_derivatives(JobPtr job) {
+  try {
+    processor_.render_derivatives(*job);
+  } catch (const std::exception &e) {
+    return fail(*job, e.what());
+  }
+  // The pixels are not needed by the DB stage; free them before queueing.
+  job->decoded.reset();
+  release_memory(*job);
+  persist_queue_.push(std::move(job));
+}
+
+void ImportPipeline::persist_loop() {
+  std::vector<JobPtr> batch;
+  while (auto job = persist_queue_.pop()) {
+    // Take whatever else is already waiting; never wait to fill a batch.
+    batch.push_back(std::move(*job));
+    while (batch.size() < options_.persist_batch_size) {
+      auto more = persist_queue_.try_pop();
+      if (!more)
+        break;
+      batch.push_back(std::move(*more));
+    }
+    persist_batch(batch);
+    batch.clear();
+  }
+}
+
+void ImportPipeline::persist_batch(std::vector<JobPtr> &batch) {
+  std::vector<PhotoJob *> jobs;
+  jobs.reserve(batch.size());
+  for (auto &job : batch)
+    jobs.push_back(job.get());
+
+  try {
+    processor_.persist(jobs);
+    for (auto *job : jobs) {
+      stats_.imported.fetch_add(1);
+      if (options_.log_each_file)
+        std::println("  ✓ {}", job->file_path.string());
+      release_slot(*job, nullptr);
+    }
+    return;
+  } catch (const std::exception &e) {
+    if (jobs.size() == 1) {
+      fail(*jobs.front(), e.what());
+      return;
+    }
+  }
+
+  // The transaction was rolled back; retry one by one so a single bad photo
+  // does not fail the rest of the batch.
+  for (auto &job : batch) {
+    std::vector<JobPtr> single{job};
+    persist_batch(single);
+  }
+}
+
+void ImportPipeline::release_slot(PhotoJob &job, const char *error) {
+  release_memory(job);
+  if (options_.on_complete)
+    options_.on_complete(job, error);
+  in_flight_.fetch_sub(1);
+  slots_.release();
+}
+
+PipelineDepths ImportPipeline::depths() const {
+  PipelineDepths d;
+  d.scan_queue = scan_queue_.size();
+  d.pool_queue = pool_.queued();
+  d.persist_queue = persist_queue_.size();
+  d.in_flight = in_flight_.load();
+  return d;
+}
+
+void ImportPipeline::fail(PhotoJob &job, const char *what) {
+  processor_.abandon(job);
+  stats_.failed.fetch_add(1);
+  std::println(stderr, "  ✗ Error processing {}: {}",
+               job.file_path.filename().string(), what);
+  release_slot(job, what);
+}
+
+} // namespace importer
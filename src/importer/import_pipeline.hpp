@@ -0,0 +1,172 @@
+/**
+ * SPDX-FileComment: Staged parallel import pipeline
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file import_pipeline.hpp
+ * @brief scan -> read -> metadata -> derivatives -> persist pipeline
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include "bounded_queue.hpp"
+#include "memory_budget.hpp"
+#include "photo_processor.hpp"
+#include "work_stealing_pool.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <semaphore>
+#include <thread>
+#include <vector>
+
+namespace importer {
+
+/**
+ * @struct PipelineOptions
+ * @brief Sizing of the pipeline stages and queues.
+ */
+struct PipelineOptions {
+  std::size_t jobs = 0;          ///< CPU workers; 0 = hardware concurrency.
+  std::size_t max_in_flight = 0; ///< Photos between read and persist; 0 = 2x jobs.
+  std::size_t persist_workers = 2;          ///< Concurrent DB writers.
+  std::size_t scan_queue_capacity = 4096;   ///< Paths the scanner may run ahead.
+  std::size_t persist_queue_capacity = 64;  ///< Photos waiting for the DB.
+  std::size_t persist_batch_size = 32;      ///< Photos per DB transaction.
+  std::size_t prefetch_depth = 0; ///< Files read ahead by the kernel; 0 = jobs.
+  /// Ask the kernel to read whole files ahead; off when stages only look at
+  /// the first pages of each file.
+  bool prefetch_files = true;
+  bool log_each_file = true; ///< Print a line per imported photo.
+  /// Bytes that admitted photos may hold from read until their thumbnails
+  /// are written (estimated from the header); 0 = unlimited.
+  std::size_t max_decode_mem = 0;
+  /// Called once per admitted photo when it is persisted, skipped
+  /// (error == nullptr) or has failed. Runs on pipeline threads.
+  std::function<void(const PhotoJob &job, const char *error)> on_complete;
+};
+
+/**
+ * @struct PipelineStats
+ * @brief Counters updated by the pipeline stages.
+ */
+struct PipelineStats {
+  std::atomic<std::size_t> submitted{0};
+  std::atomic<std::size_t> imported{0};
+  std::atomic<std::size_t> skipped{0};
+  std::atomic<std::size_t> failed{0};
+  std::atomic<std::size_t> files_read{0}; ///< Originals read into memory.
+  std::atomic<std::size_t> bytes_read{0}; ///< Total size of those reads.
+};
+
+/**
+ * @struct PipelineDepths
+ * @brief Snapshot of how much work waits in front of each stage.
+ */
+struct PipelineDepths {
+  std::size_t scan_queue = 0;    ///< Paths not yet admitted.
+  std::size_t pool_queue = 0;    ///< Stage tasks waiting for a worker.
+  std::size_t persist_queue = 0; ///< Photos waiting for a DB writer.
+  std::size_t in_flight = 0;     ///< Admitted photos not yet finished.
+};
+
+/**
+ * @class ImportPipeline
+ * @brief Runs PhotoProcessor stages in parallel with bounded backpressure.
+ *
+ * The scanner feeds paths through a bounded queue. A dispatcher admits at
+ * most max_in_flight photos into the work-stealing pool, where read,
+ * metadata and derivative stages run as chained tasks. Finished photos go
+ * through a second bounded queue to a small set of DB writer threads, which
+ * store whatever has accumulated (up to persist_batch_size) in one
+ * transaction. A slot
+ * is only returned once the photo is persisted, so a slow database stops new
+ * decodes instead of letting decoded images accumulate.
+ */
+class ImportPipeline {
+public:
+  ImportPipeline(PhotoProcessor &processor, PipelineOptions options);
+
+  /**
+   * @brief Drains and stops the pipeline (see finish()).
+   */
+  ~ImportPipeline();
+
+  ImportPipeline(const ImportPipeline &) = delete;
+  ImportPipeline &operator=(const ImportPipeline &) = delete;
+
+  /**
+   * @brief Queues a file for import; blocks while the scan queue is full.
+   * @param base_path Library root the file's location is derived from.
+   * @param file_path The photo to import.
+   * @param queue_id import_jobs row the photo was claimed from, if any.
+   * @return false if the pipeline is already finishing.
+   */
+  bool submit(const std::filesystem::path &base_path,
+              const std::filesystem::path &file_path,
+              std::optional<std::int64_t> queue_id = std::nullopt);
+
+  /**
+   * @brief Queues a file whose bytes are already in memory; the read stage
+   * uses them instead of reading @p file_path again.
+   */
+  bool submit(const std::filesystem::path &base_path,
+              const std::filesystem::path &file_path, FileBuffer source);
+
+  /**
+   * @brief Stops accepting files and waits until every queued photo has
+   * been persisted or has failed.
+   */
+  void finish();
+
+  const PipelineStats &stats() const { return stats_; }
+
+  /**
+   * @brief Current queue depths; cheap enough to poll periodically.
+   */
+  PipelineDepths depths() const;
+
+private:
+  using JobPtr = std::shared_ptr<PhotoJob>;
+
+  void dispatch_loop();
+  void persist_loop();
+  void persist_batch(std::vector<JobPtr> &batch);
+  void run_read(JobPtr job);
+  void run_metadata(JobPtr job);
+  void run_derivatives(JobPtr job);
+  void reserve_memory(PhotoJob &job);
+  void release_memory(PhotoJob &job);
+  void fail(PhotoJob &job, const char *what);
+  void release_slot(PhotoJob &job, const char *error);
+
+  PhotoProcessor &processor_;
+  PipelineOptions options_;
+  PipelineStats stats_;
+
+  BoundedQueue<JobPtr> scan_queue_;
+  BoundedQueue<JobPtr> persist_queue_;
+  std::counting_semaphore<> slots_;
+  std::atomic<std::size_t> in_flight_{0};
+  std::unique_ptr<MemoryBudget> memory_; ///< Only with max_decode_mem.
+  WorkStealingPool pool_;
+
+  std::thread dispatcher_;
+  std::vector<std::thread> persisters_;
+  bool finished_ = false;
+};
+
+} // namespace importer
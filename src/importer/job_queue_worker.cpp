@@ -0,0 +1,136 @@
+/**
+ * SPDX-FileComment: Worker side of the distributed import queue implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file job_queue_worker.cpp
+ * @brief Claims import jobs, feeds the pipeline and reports outcomes
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "job_queue_worker.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <format>
+#include <print>
+#include <thread>
+#include <unistd.h>
+
+namespace importer {
+
+static std::string worker_name() {
+  char host[256] = {};
+  if (::gethostname(host, sizeof(host) - 1) != 0)
+    std::snprintf(host, sizeof(host), "unknown");
+  return std::format("{}:{}", host, ::getpid());
+}
+
+JobQueueWorker::JobQueueWorker(domain::interfaces::IImportJobRepository &jobs,
+                               QueueWorkerOptions options)
+    : jobs_(jobs), options_(options), name_(worker_name()) {}
+
+void JobQueueWorker::on_complete(const PhotoJob &job, const char *error) {
+  if (!job.queue_id)
+    return;
+  std::lock_guard lock(mutex_);
+  if (error)
+    failed_.push_back({*job.queue_id, error});
+  else
+    done_.push_back(*job.queue_id);
+}
+
+void JobQueueWorker::flush_outcomes() {
+  std::vector<std::int64_t> done;
+  std::vector<Failure> failed;
+  {
+    std::lock_guard lock(mutex_);
+    done.swap(done_);
+    failed.swap(failed_);
+    for (auto id : done)
+      held_.erase(id);
+    for (const auto &f : failed)
+      held_.erase(f.id);
+  }
+
+  if (auto res = jobs_.complete(name_, done); !res)
+    std::println(stderr, "Queue: could not mark jobs done: {}", res.error());
+  for (const auto &f : failed) {
+    if (auto res = jobs_.fail(name_, f.id, f.error); !res)
+      std::println(stderr, "Queue: could not record failure: {}", res.error());
+  }
+}
+
+void JobQueueWorker::renew_leases() {
+  std::vector<std::int64_t> ids;
+  {
+    std::lock_guard lock(mutex_);
+    ids.assign(held_.begin(), held_.end());
+  }
+  if (auto res = jobs_.renew(name_, ids, options_.lease); !res)
+    std::println(stderr, "Queue: could not renew leases: {}", res.error());
+}
+
+void JobQueueWorker::run(ImportPipeline &pipeline, std::stop_token stop) {
+  const std::size_t batch = std::max<std::size_t>(options_.claim_batch, 1);
+  // Renew well before expiry so a slow DB round trip cannot lose a lease.
+  const auto renew_every = options_.lease / 3;
+  auto last_renew = std::chrono::steady_clock::now();
+
+  while (!stop.stop_requested()) {
+    flush_outcomes();
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now - last_renew >= renew_every) {
+      renew_leases();
+      last_renew = now;
+    }
+
+    std::size_t claimed = 0;
+    if (pipeline.depths().scan_queue < batch) {
+      if (auto expired = jobs_.expire_exhausted(); expired && *expired > 0)
+        std::println(stderr, "Queue: {} jobs failed after lease expiry",
+                     *expired);
+
+      auto jobs = jobs_.claim(name_, batch, options_.lease);
+      if (!jobs) {
+        std::println(stderr, "Queue: claim failed: {}", jobs.error());
+      } else {
+        claimed = jobs->size();
+        {
+          std::lock_guard lock(mutex_);
+          for (const auto &job : *jobs)
+            held_.insert(job.id);
+        }
+        for (const auto &job : *jobs)
+          pipeline.submit(job.base_path, job.file_path, job.id);
+      }
+    }
+
+    if (claimed == 0) {
+      bool idle = false;
+      {
+        std::lock_guard lock(mutex_);
+        idle = held_.empty() && done_.empty() && failed_.empty();
+      }
+      if (idle) {
+        // Jobs running on other workers may still come back as pending.
+        auto counts = jobs_.counts();
+        if (counts && counts->pending == 0 && counts->running == 0)
+          break;
+      }
+      std::this_thread::sleep_for(options_.poll_interval);
+    }
+  }
+
+  flush_outcomes();
+}
+
+} // namespace importer
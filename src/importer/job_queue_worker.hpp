@@ -0,0 +1,92 @@
+/**
+ * SPDX-FileComment: Worker side of the distributed import queue
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file job_queue_worker.hpp
+ * @brief Claims import jobs, feeds the pipeline and reports outcomes
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include "domain/interfaces/i_import_job_repository.hpp"
+#include "import_pipeline.hpp"
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace importer {
+
+/**
+ * @struct QueueWorkerOptions
+ * @brief Claim and lease settings of a queue worker.
+ */
+struct QueueWorkerOptions {
+  std::chrono::seconds lease{300}; ///< Renewed while the job is in flight.
+  std::size_t claim_batch = 64;    ///< Jobs per claim.
+  std::chrono::milliseconds poll_interval{2000}; ///< Idle wait between claims.
+};
+
+/**
+ * @class JobQueueWorker
+ * @brief Drives an ImportPipeline from the import_jobs table.
+ *
+ * Jobs are claimed in batches whenever the pipeline's scan queue runs low.
+ * Outcomes are collected from the pipeline threads and written back in
+ * batches by the worker loop, which also renews the leases of jobs still in
+ * flight. run() returns once no job is pending or running anywhere.
+ */
+class JobQueueWorker {
+public:
+  JobQueueWorker(domain::interfaces::IImportJobRepository &jobs,
+                 QueueWorkerOptions options);
+
+  /**
+   * @brief Unique name of this process ("host:pid").
+   */
+  const std::string &name() const { return name_; }
+
+  /**
+   * @brief Completion hook to install as PipelineOptions::on_complete.
+   */
+  void on_complete(const PhotoJob &job, const char *error);
+
+  /**
+   * @brief Claims and processes jobs until the queue is drained or a stop
+   * is requested.
+   */
+  void run(ImportPipeline &pipeline, std::stop_token stop);
+
+private:
+  struct Failure {
+    std::int64_t id;
+    std::string error;
+  };
+
+  void flush_outcomes();
+  void renew_leases();
+
+  domain::interfaces::IImportJobRepository &jobs_;
+  QueueWorkerOptions options_;
+  std::string name_;
+
+  std::mutex mutex_;
+  std::unordered_set<std::int64_t> held_; ///< Claimed, not yet reported.
+  std::vector<std::int64_t> done_;
+  std::vector<Failure> failed_;
+};
+
+} // namespace importer
@@ -0,0 +1,91 @@
+/**
+ * SPDX-FileComment: In-memory location resolver for the importer
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file location_cache.cpp
+ * @brief Thread-safe (continent, country, province, city) -> id cache
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "location_cache.hpp"
+#include <mutex>
+
+namespace importer {
+
+LocationCache::LocationCache(
+    domain::interfaces::ILocationRepository &locations)
+    : locations_(locations) {}
+
+std::string LocationCache::key_of(std::string_view continent,
+                                  std::string_view country,
+                                  std::string_view province,
+                                  std::string_view city) {
+  // Unit separator: cannot appear in a directory name component.
+  std::string key;
+  key.reserve(continent.size() + country.size() + province.size() +
+              city.size() + 3);
+  key.append(continent).append(1, '\x1f');
+  key.append(country).append(1, '\x1f');
+  key.append(province).append(1, '\x1f');
+  key.append(city);
+  return key;
+}
+
+std::expected<void, std::string> LocationCache::preload() {
+  auto rows = locations_.find_all();
+  if (!rows)
+    return std::unexpected(rows.error());
+
+  std::unique_lock lock(mutex_);
+  for (const auto &loc : *rows) {
+    ids_.insert_or_assign(key_of(loc.continent.value_or(""),
+                                 loc.country.value_or(""),
+                                 loc.province.value_or(""),
+                                 loc.city.value_or("")),
+                          loc.id);
+  }
+  return {};
+}
+
+std::expected<std::string, std::string>
+LocationCache::resolve(const infra::util::GeoInfo &geo) {
+  auto key = key_of(geo.continent.value_or(""), geo.country.value_or(""),
+                    geo.province.value_or(""), geo.city.value_or(""));
+  {
+    std::shared_lock lock(mutex_);
+    if (auto it = ids_.find(key); it != ids_.end())
+      return it->second;
+  }
+
+  domain::models::Location loc;
+  loc.continent = geo.continent;
+  loc.country = geo.country;
+  loc.province = geo.province;
+  loc.city = geo.city;
+  auto created = locations_.find_or_create(loc);
+  if (!created)
+    return std::unexpected(created.error());
+  if (!*created)
+    return std::unexpected("Location upsert returned no row");
+
+  std::unique_lock lock(mutex_);
+  // Both racers got the same id from the upsert; keeping either is fine.
+  auto [it, inserted] = ids_.try_emplace(std::move(key), (*created)->id);
+  return it->second;
+}
+
+std::size_t LocationCache::size() const {
+  std::shared_lock lock(mutex_);
+  return ids_.size();
+}
+
+} // namespace importer
@@ -0,0 +1,65 @@
+/**
+ * SPDX-FileComment: In-memory location resolver for the importer
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file location_cache.hpp
+ * @brief Thread-safe (continent, country, province, city) -> id cache
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include "domain/interfaces/i_photo_repository.hpp"
+#include "infra/util/path_parser.hpp"
+#include <expected>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace importer {
+
+/**
+ * @class LocationCache
+ * @brief Resolves location ids from memory, creating missing rows once.
+ *
+ * Preloaded from the locations table; misses go through the atomic upsert
+ * of ILocationRepository::find_or_create, so concurrent workers and
+ * concurrent importer processes agree on one row per location.
+ */
+class LocationCache {
+public:
+  explicit LocationCache(domain::interfaces::ILocationRepository &locations);
+
+  /**
+   * @brief Loads all existing locations.
+   */
+  std::expected<void, std::string> preload();
+
+  /**
+   * @brief Returns the id of the location, creating it if needed.
+   */
+  std::expected<std::string, std::string>
+  resolve(const infra::util::GeoInfo &geo);
+
+  std::size_t size() const;
+
+private:
+  static std::string key_of(std::string_view continent,
+                            std::string_view country,
+                            std::string_view province, std::string_view city);
+
+  domain::interfaces::ILocationRepository &locations_;
+  mutable std::shared_mutex mutex_;
+  std::unordered_map<std::string, std::string> ids_;
+};
+
+} // namespace importer
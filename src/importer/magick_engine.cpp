@@ -0,0 +1,178 @@
+/**
+ * SPDX-FileComment: ImageMagick image engine
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file magick_engine.cpp
+ * @brief Image engine backed by Magick++
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "magick_engine.hpp"
+#include "embedded_preview.hpp"
+#include <Magick++.h>
+#include <algorithm>
+#include <cmath>
+#include <format>
+
+namespace importer {
+
+namespace {
+
+class MagickImage : public DecodedImage {
+public:
+  Magick::Image image;
+  /// Embedded preview for the sizes it covers; empty if unused. When it
+  /// covers every size it is decoded into image instead.
+  Magick::Image preview;
+};
+
+/**
+ * @brief Decode geometry for libjpeg's DCT-domain scaling.
+ *
+ * ImageMagick picks the largest 1/N scale whose output still covers this
+ * geometry in both dimensions, so the hint is the box-fitted size of the
+ * largest derivative rather than a square box.
+ *
+ * @return std::nullopt if the original already fits the box.
+ */
+std::optional<std::string> jpeg_size_hint(std::size_t columns,
+                                          std::size_t rows, int box) {
+  const auto edge = std::max(columns, rows);
+  if (box <= 0 || edge <= static_cast<std::size_t>(box))
+    return std::nullopt;
+  const double scale = static_cast<double>(box) / static_cast<double>(edge);
+  auto scaled = [scale](std::size_t n) {
+    return static_cast<std::size_t>(std::ceil(static_cast<double>(n) * scale));
+  };
+  return std::format("{}x{}", scaled(columns), scaled(rows));
+}
+
+Raster to_raster(const Magick::Image &image) {
+  Raster raster;
+  raster.width = image.columns();
+  raster.height = image.rows();
+  raster.rgba.resize(raster.width * raster.height * 4);
+  // write() is const in spirit but not in signature; work on a handle copy.
+  Magick::Image source = image;
+  source.write(0, 0, raster.width, raster.height, "RGBA", Magick::CharPixel,
+               raster.rgba.data());
+  return raster;
+}
+
+} // namespace
+
+ImageInfo MagickEngine::probe(std::span<const std::uint8_t> data) const {
+  Magick::Image ping;
+  ping.ping(Magick::Blob(data.data(), data.size()));
+  return {static_cast<int>(ping.columns()), static_cast<int>(ping.rows()),
+          ping.magick()};
+}
+
+std::unique_ptr<DecodedImage>
+MagickEngine::decode(std::span<const std::uint8_t> data, const ImageInfo &info,
+                     const DerivativeGenerator &ladder,
+                     const DecodeOptions &options) const {
+  auto decoded = std::make_unique<MagickImage>();
+  const auto &sizes = ladder.sizes();
+
+  // PNG has no preview; for everything else ask Exiv2 before decoding.
+  if (options.use_previews && info.format != "PNG") {
+    auto preview =
+        read_embedded_preview(data, info.width, info.height, sizes.back());
+    if (preview) {
+      const auto edge = std::max(preview->columns(), preview->rows());
+      if (DerivativeGenerator::covers(edge, sizes.front())) {
+        decoded->image = std::move(*preview);
+        decoded->from_preview = true;
+        return decoded;
+      }
+      // With cascading, sizes below the first full-decode size come from
+      // that derivative, which is cheaper than the preview.
+      if (ladder.mode() == ResizeMode::Independent)
+        decoded->preview = std::move(*preview);
+    }
+  }
+
+  if (options.shrink_on_load && info.format == "JPEG") {
+    if (auto hint = jpeg_size_hint(static_cast<std::size_t>(info.width),
+                                   static_cast<std::size_t>(info.height),
+                                   sizes.front())) {
+      decoded->image.defineValue("jpeg", "size", *hint);
+    }
+  }
+  // Copies the bytes into ImageMagick, but does not touch the disk again.
+  decoded->image.read(Magick::Blob(data.data(), data.size()));
+  return decoded;
+}
+
+std::vector<Thumbnail>
+MagickEngine::render(DecodedImage &image,
+                     const DerivativeGenerator &ladder) const {
+  auto &decoded = static_cast<MagickImage &>(image);
+  // Export once and drop the pixel cache; the ladder is resampled on the
+  // 8-bit copy.
+  std::optional<Raster> preview;
+  if (decoded.preview.isValid()) {
+    preview = to_raster(decoded.preview);
+    decoded.preview = Magick::Image();
+  }
+  Raster original;
+  if (decoded.image.isValid()) {
+    original = to_raster(decoded.image);
+    decoded.image = Magick::Image();
+  }
+  return ladder.generate(original, preview ? &*preview : nullptr);
+}
+
+std::size_t
+MagickEngine::estimate_memory(const std::optional<HeaderInfo> &header,
+                              std::size_t file_size,
+                              const DerivativeGenerator &ladder,
+                              bool shrink_on_load) const {
+  // ImageMagick keeps RGBA at its quantum depth per channel.
+  constexpr std::size_t kBytesPerPixel = 4 * sizeof(Magick::Quantum);
+  // Unknown container: assume a compression ratio of about 1:10.
+  constexpr std::size_t kUnknownRatio = 10;
+
+  // The file buffer plus the Blob copy handed to the decoder.
+  std::size_t bytes = 2 * file_size;
+
+  if (!header || header->width <= 0 || header->height <= 0) {
+    bytes += file_size * kUnknownRatio;
+  } else {
+    auto columns = static_cast<std::size_t>(header->width);
+    auto rows = static_cast<std::size_t>(header->height);
+    if (shrink_on_load && header->format == "JPEG") {
+      // libjpeg scales by 1/2, 1/4 or 1/8 while the result covers the box.
+      const auto box = static_cast<std::size_t>(ladder.sizes().front());
+      for (int step = 0; step < 3 && std::max(columns, rows) / 2 >= box;
+           ++step) {
+        columns = (columns + 1) / 2;
+        rows = (rows + 1) / 2;
+      }
+    }
+    // The pixel cache and, briefly, its 8-bit RGBA export.
+    bytes += columns * rows * (kBytesPerPixel + 4);
+    // The resampler's intermediate: the largest width by the full height.
+    bytes += static_cast<std::size_t>(ladder.sizes().front()) *
+             std::max(columns, rows) * 4;
+  }
+
+  // Every size as 8-bit RGBA until it is encoded.
+  for (int size : ladder.sizes()) {
+    const auto edge = static_cast<std::size_t>(size);
+    bytes += edge * edge * 4;
+  }
+  return bytes;
+}
+
+} // namespace importer
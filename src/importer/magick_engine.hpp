@@ -0,0 +1,50 @@
+/**
+ * SPDX-FileComment: ImageMagick image engine
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file magick_engine.hpp
+ * @brief Image engine backed by Magick++
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include "image_engine.hpp"
+
+namespace importer {
+
+/**
+ * @class MagickEngine
+ * @brief Decodes the whole original into ImageMagick's pixel cache.
+ *
+ * Large JPEGs are decoded at 1/2, 1/4 or 1/8 scale when that still covers
+ * the largest size, and an embedded camera preview replaces the decode
+ * when it covers every size. render() exports the decoded image to 8-bit
+ * RGBA once and DerivativeGenerator resamples the ladder from that.
+ */
+class MagickEngine : public IImageEngine {
+public:
+  ImageEngineKind kind() const override { return ImageEngineKind::Magick; }
+  ImageInfo probe(std::span<const std::uint8_t> data) const override;
+  std::unique_ptr<DecodedImage>
+  decode(std::span<const std::uint8_t> data, const ImageInfo &info,
+         const DerivativeGenerator &ladder,
+         const DecodeOptions &options) const override;
+  std::vector<Thumbnail>
+  render(DecodedImage &image, const DerivativeGenerator &ladder) const override;
+  std::size_t estimate_memory(const std::optional<HeaderInfo> &header,
+                              std::size_t file_size,
+                              const DerivativeGenerator &ladder,
+                              bool shrink_on_load) const override;
+};
+
+} // namespace importer
@@ -0,0 +1,81 @@
+/**
+ * SPDX-FileComment: Byte budget for decoded images
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file memory_budget.hpp
+ * @brief Blocking reservations against a fixed number of bytes
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace importer {
+
+/**
+ * @class MemoryBudget
+ * @brief Counting semaphore measured in bytes.
+ *
+ * acquire() blocks until the requested amount fits next to what is already
+ * reserved, release() gives bytes back.
+ */
+class MemoryBudget {
+public:
+  explicit MemoryBudget(std::size_t capacity) : capacity_(capacity) {}
+
+  MemoryBudget(const MemoryBudget &) = delete;
+  MemoryBudget &operator=(const MemoryBudget &) = delete;
+
+  /**
+   * @brief Reserves @p bytes, blocking while they do not fit.
+   * @return false if @p bytes exceeds the capacity and can never fit.
+   */
+  bool acquire(std::size_t bytes) {
+    if (bytes > capacity_)
+      return false;
+    std::unique_lock lock(mutex_);
+    released_.wait(lock, [&] { return used_ + bytes <= capacity_; });
+    used_ += bytes;
+    return true;
+  }
+
+  /**
+   * @brief Returns bytes obtained from acquire().
+   */
+  void release(std::size_t bytes) {
+    if (bytes == 0)
+      return;
+    {
+      std::lock_guard lock(mutex_);
+      used_ -= bytes;
+    }
+    released_.notify_all();
+  }
+
+  std::size_t capacity() const { return capacity_; }
+
+  std::size_t used() const {
+    std::lock_guard lock(mutex_);
+    return used_;
+  }
+
+private:
+  const std::size_t capacity_;
+  mutable std::mutex mutex_;
+  std::condition_variable released_;
+  std::size_t used_ = 0;
+};
+
+} // namespace importer
@@ -0,0 +1,493 @@
+/**
+ * SPDX-FileComment: Per-photo import stages implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file photo_processor.cpp
+ * @brief Read, metadata, derivative and persist stages for a single photo
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "photo_processor.hpp"
+#include "exif_utils.hpp"
+#include "file_fingerprint.hpp"
+#include "header_reader.hpp"
+#include "placeholder.hpp"
+#include "infra/util/path_parser.hpp"
+#include <Magick++.h>
+#include <algorithm>
+#include <exiv2/exiv2.hpp>
+#include <format>
+#include <pthread.h>
+#include <stdexcept>
+#include <uuid/uuid.h>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace importer {
+
+/**
+ * @brief Generates a universally unique identifier (UUID).
+ */
+static std::string generate_uuid() {
+  uuid_t b_uuid;
+  uuid_generate(b_uuid);
+  char out[37];
+  uuid_unparse_lower(b_uuid, out);
+  return std::string(out);
+}
+
+PhotoProcessor::PhotoProcessor(domain::interfaces::IPhotoRepository &photos,
+                               LocationCache &locations,
+                               ProcessorOptions options,
+                               ImportManifest *manifest,
+                               ImportMetrics *metrics, ThumbPackStore *packs)
+    : photos_(photos), locations_(locations), options_(options),
+      derivatives_(options.thumb_sizes, options.resize_mode),
+      engine_(make_image_engine(options.engine)),
+      encoder_(options.encoder, options.webp),
+      duplicates_(photos), manifest_(manifest), metrics_(metrics),
+      packs_(packs) {
+  if (metrics_)
+    metrics_->add_thumbnail_sizes(derivatives_.sizes());
+}
+
+void PhotoProcessor::init_codecs(const char *argv0) {
+  Magick::InitializeMagick(argv0);
+  // The pipeline already runs one photo per core; letting ImageMagick's
+  // OpenMP spawn another team per resize only oversubscribes the machine.
+  Magick::ResourceLimits::thread(1);
+  // The XMP toolkit is not thread-safe to initialise lazily.
+  Exiv2::XmpParser::initialize();
+}
+
+void PhotoProcessor::limit_memory(std::size_t bytes) {
+  if (bytes == 0)
+    return;
+  Magick::ResourceLimits::memory(bytes);
+  Magick::ResourceLimits::map(bytes);
+}
+
+std::size_t
+PhotoProcessor::estimate_memory(const std::optional<HeaderInfo> &header,
+                                std::size_t file_size) const {
+  if (options_.metadata_only)
+    return 0;
+  return engine_->estimate_memory(header, file_size, derivatives_,
+                                  options_.shrink_on_load);
+}
+
+void PhotoProcessor::init_worker_thread(std::size_t index) {
+  auto name = std::format("import-w{}", index);
+  name.resize(std::min<std::size_t>(name.size(), 15));
+  pthread_setname_np(pthread_self(), name.c_str());
+}
+
+bool PhotoProcessor::read(PhotoJob &job) {
+  auto &photo = job.photo;
+  photo.id = generate_uuid();
+  photo.file_name = job.file_path.filename().string();
+  photo.file_path = job.file_path.string();
+
+  // Exiv2 opens the file itself and reads only the metadata segments; the
+  // header reader reads the start of the file up to the first SOF marker.
+  if (options_.metadata_only) {
+    if (!options_.full_metadata) {
+      StageTimer timer(timing(Stage::Read));
+      auto header = read_header(job.file_path);
+      if (!header)
+        throw std::runtime_error(header.error());
+      job.header = std::move(*header);
+    }
+    return true;
+  }
+
+  std::optional<FileFingerprint> fp;
+  std::optional<domain::models::ManifestEntry> known;
+  if (manifest_) {
+    auto stat = stat_fingerprint(job.file_path);
+    if (!stat)
+      throw std::runtime_error(stat.error());
+    fp = *stat;
+
+    known = manifest_->find(photo.file_path);
+    if (known && known->photo_id && known->file_size == fp->size &&
+        known->mtime_ns == fp->mtime_ns && known->inode == fp->inode) {
+      return false;
+    }
+  }
+
+  // Everything below works on this one copy of the file. Archive entries
+  // arrive with it already loaded.
+  if (job.source.empty()) {
+    StageTimer timer(timing(Stage::Read));
+    auto source = FileBuffer::read(job.file_path);
+    if (!source)
+      throw std::runtime_error(source.error());
+    job.source = std::move(*source);
+  }
+
+  std::expected<std::string, std::string> hash;
+  {
+    StageTimer timer(timing(Stage::Hash));
+    hash = hash_bytes(job.source.bytes());
+  }
+  if (!hash)
+    throw std::runtime_error(hash.error());
+  photo.content_hash = *hash;
+
+  if (manifest_) {
+    domain::models::ManifestEntry entry;
+    entry.file_path = photo.file_path;
+    entry.file_size = fp->size;
+    entry.mtime_ns = fp->mtime_ns;
+    entry.inode = fp->inode;
+    entry.content_hash = *hash;
+
+    // Touched, copied back or restored from backup: same bytes, so only the
+    // recorded stat data needs refreshing.
+    if (known && known->photo_id && known->content_hash == *hash) {
+      entry.photo_id = known->photo_id;
+      if (auto res = manifest_->record(entry); !res)
+        throw std::runtime_error(res.error());
+      return false;
+    }
+    job.manifest_entry = std::move(entry);
+  }
+
+  // Byte-identical to a photo that already has thumbnails: point at those
+  // and skip the decode.
+  if (auto shared = duplicates_.claim(*hash, {own_thumb_path(job), {}, {}})) {
+    photo.thumb_path = shared->thumb_path;
+    job.shared_derivatives = true;
+    if (shared->width && shared->height) {
+      photo.width = shared->width;
+      photo.height = shared->height;
+      return true;
+    }
+  }
+
+  StageTimer timer(timing(Stage::Decode));
+  // The header gives the true dimensions; with shrink-on-load the decoded
+  // image is smaller than the original.
+  ImageInfo info;
+  if (auto header = parse_header(job.source.bytes())) {
+    info = {header->width, header->height, header->format};
+    job.header = std::move(*header);
+  } else {
+    info = engine_->probe(job.source.bytes());
+  }
+  photo.width = info.width;
+  photo.height = info.height;
+  if (job.shared_derivatives)
+    return true;
+  if (!job.over_budget.empty())
+    throw std::runtime_error(job.over_budget);
+
+  job.decoded = engine_->decode(job.source.bytes(), info, derivatives_,
+                                {options_.shrink_on_load,
+                                 options_.use_previews});
+  if (job.decoded->from_preview && metrics_)
+    metrics_->count_preview();
+  return true;
+}
+
+void PhotoProcessor::read_full_metadata(PhotoJob &job) {
+  auto &photo = job.photo;
+
+  try {
+    auto exiv_image =
+        job.source.empty()
+            ? Exiv2::ImageFactory::open(job.file_path.string())
+            : Exiv2::ImageFactory::open(job.source.data(), job.source.size());
+    exiv_image->readMetadata();
+
+    // 1. EXIF
+    auto &exifData = exiv_image->exifData();
+    if (!exifData.empty()) {
+      for (auto it = exifData.begin(); it != exifData.end(); ++it) {
+        photo.exif[it->key()] = it->toString();
+      }
+      photo.camera_make = exifData["Exif.Image.Make"].toString();
+      photo.camera_model = exifData["Exif.Image.Model"].toString();
+
+      // Date Fallback Logic Step 1 & 2: EXIF
+      photo.taken_at =
+          parse_exif_date(exifData["Exif.Photo.DateTimeOriginal"].toString());
+      if (!photo.taken_at) {
+        photo.taken_at =
+            parse_exif_date(exifData["Exif.Image.DateTime"].toString());
+      }
+
+      photo.gps_lat = get_gps_coordinate(exifData, "Exif.GPSInfo.GPSLatitude",
+                                         "Exif.GPSInfo.GPSLatitudeRef");
+      photo.gps_lon = get_gps_coordinate(exifData, "Exif.GPSInfo.GPSLongitude",
+                                         "Exif.GPSInfo.GPSLongitudeRef");
+      photo.gps_alt = get_gps_altitude(exifData);
+    }
+
+    // 2. IPTC
+    auto &iptcData = exiv_image->iptcData();
+    for (auto it = iptcData.begin(); it != iptcData.end(); ++it) {
+      photo.iptc[it->key()] = it->toString();
+      if (it->key() == "Iptc.Application2.Keywords") {
+        photo.tags.push_back(it->toString());
+      }
+    }
+
+    // 3. XMP
+    auto &xmpData = exiv_image->xmpData();
+    for (auto it = xmpData.begin(); it != xmpData.end(); ++it) {
+      photo.xmp[it->key()] = it->toString();
+      if (it->key() == "Xmp.dc.subject") {
+        photo.tags.push_back(it->toString());
+      }
+    }
+
+  } catch (...) {
+  }
+}
+
+void PhotoProcessor::apply_header(domain::models::Photo &photo,
+                                  const HeaderInfo &header) {
+  // Recorded under Exiv2's key names so both modes fill the same rows.
+  auto record = [&photo](const char *key, const std::string &value) {
+    if (!value.empty())
+      photo.exif[key] = value;
+  };
+  record("Exif.Image.Make", header.make);
+  record("Exif.Image.Model", header.model);
+  record("Exif.Image.DateTime", header.date_time);
+  record("Exif.Photo.DateTimeOriginal", header.date_time_original);
+  if (header.orientation)
+    record("Exif.Image.Orientation", std::to_string(*header.orientation));
+
+  if (!header.make.empty())
+    photo.camera_make = header.make;
+  if (!header.model.empty())
+    photo.camera_model = header.model;
+
+  photo.taken_at = parse_exif_date(header.date_time_original);
+  if (!photo.taken_at)
+    photo.taken_at = parse_exif_date(header.date_time);
+
+  photo.gps_lat = header.gps_lat;
+  photo.gps_lon = header.gps_lon;
+  photo.gps_alt = header.gps_alt;
+}
+
+void PhotoProcessor::extract_metadata(PhotoJob &job) {
+  StageTimer timer(timing(Stage::Metadata));
+  auto &photo = job.photo;
+
+  if (options_.full_metadata) {
+    read_full_metadata(job);
+  } else {
+    if (!job.header) {
+      if (auto header = parse_header(job.source.bytes()))
+        job.header = std::move(*header);
+    }
+    if (job.header)
+      apply_header(photo, *job.header);
+  }
+
+  // Date Fallback Logic Step 3: Filename
+  if (!photo.taken_at) {
+    photo.taken_at = parse_date_from_filename(photo.file_name);
+  }
+
+  // Date Fallback Logic Step 4: File System Last Modified
+  if (!photo.taken_at) {
+    auto ftime = fs::last_write_time(job.file_path);
+    auto sctp =
+        std::chrono::time_point_cast<std::chrono::system_clock::duration>(
+            ftime - fs::file_time_type::clock::now() +
+            std::chrono::system_clock::now());
+    photo.taken_at = sctp;
+  }
+}
+
+void PhotoProcessor::render_derivatives(PhotoJob &job) {
+  if (job.shared_derivatives || options_.metadata_only)
+    return;
+
+  const fs::path &thumb_base = options_.thumb_root;
+  fs::path relative_file = fs::relative(job.file_path, job.base_path);
+
+  std::vector<Thumbnail> derivatives;
+  {
+    StageTimer timer(timing(Stage::Resize));
+    derivatives = engine_->render(*job.decoded, derivatives_);
+    // The smallest thumbnail is plenty for a handful of cosine terms.
+    auto placeholder = compute_placeholder(derivatives.back().pixels);
+    job.photo.blurhash = std::move(placeholder.blurhash);
+    job.photo.dominant_color = std::move(placeholder.color);
+  }
+
+  relative_file.replace_extension(".webp");
+  job.packed.clear();
+  for (auto &derivative : derivatives) {
+    StageTimer timer(metrics_ ? &metrics_->thumbnail(derivative.size)
+                              : nullptr);
+    if (packs_) {
+      job.packed.push_back(packs_->append(relative_file.string(),
+                                          derivative.size,
+                                          encoder_.encode(derivative.pixels)));
+      continue;
+    }
+    fs::path size_path =
+        thumb_base / std::to_string(derivative.size) / relative_file;
+    fs::create_directories(size_path.parent_path());
+
+    write_file_atomic(size_path, encoder_.encode(derivative.pixels));
+  }
+
+  job.photo.thumb_path = relative_file.string();
+}
+
+void PhotoProcessor::render_sizes(const fs::path &file,
+                                  const std::string &thumb_path,
+                                  const std::vector<int> &sizes,
+                                  const std::vector<int> &sources) {
+  if (sizes.empty())
+    return;
+  DerivativeGenerator generator(sizes, options_.resize_mode);
+
+  // A thumbnail is box-fitted, so one at least as large as the biggest
+  // requested size yields the same result as the original at a fraction of
+  // the decode cost.
+  std::optional<int> from;
+  if (!packs_) {
+    for (int s : sources) {
+      if (s >= generator.sizes().front() && (!from || s < *from))
+        from = s;
+    }
+  }
+  auto source = FileBuffer::read(
+      from ? options_.thumb_root / std::to_string(*from) / thumb_path : file);
+  if (!source && from) {
+    from.reset();
+    source = FileBuffer::read(file);
+  }
+  if (!source)
+    throw std::runtime_error(source.error());
+
+  ImageInfo info;
+  if (auto header = parse_header(source->bytes()))
+    info = {header->width, header->height, header->format};
+  else
+    info = engine_->probe(source->bytes());
+  auto decoded = engine_->decode(source->bytes(), info, generator,
+                                 {options_.shrink_on_load && !from, false});
+
+  std::vector<domain::models::PackedThumbnail> packed;
+  for (auto &derivative : engine_->render(*decoded, generator)) {
+    if (packs_) {
+      packed.push_back(packs_->append(thumb_path, derivative.size,
+                                      encoder_.encode(derivative.pixels)));
+      continue;
+    }
+    fs::path size_path =
+        options_.thumb_root / std::to_string(derivative.size) / thumb_path;
+    fs::create_directories(size_path.parent_path());
+    write_file_atomic(size_path, encoder_.encode(derivative.pixels));
+  }
+  if (packs_) {
+    if (auto res = packs_->record(packed); !res)
+      throw std::runtime_error(res.error());
+  }
+}
+
+void PhotoProcessor::persist(const std::vector<PhotoJob *> &jobs) {
+  StageTimer timer(timing(Stage::Persist));
+  if (options_.metadata_only) {
+    std::vector<domain::models::Photo> batch;
+    batch.reserve(jobs.size());
+    for (auto *job : jobs)
+      batch.push_back(std::move(job->photo));
+    auto replaced = photos_.replace_metadata_batch(batch);
+    for (std::size_t i = 0; i < jobs.size(); ++i)
+      jobs[i]->photo = std::move(batch[i]);
+    if (!replaced)
+      throw std::runtime_error(replaced.error());
+    return;
+  }
+
+  for (auto *job : jobs) {
+    auto geo_path =
+        infra::util::PathParser::parse(job->base_path, job->file_path);
+    auto location_id = locations_.resolve(geo_path);
+    if (!location_id)
+      throw std::runtime_error(location_id.error());
+    job->photo.location_id = *location_id;
+  }
+
+  // Moved out for the call and back afterwards; the maps can be large.
+  std::vector<domain::models::Photo> batch;
+  batch.reserve(jobs.size());
+  for (auto *job : jobs)
+    batch.push_back(std::move(job->photo));
+
+  auto saved_ids = photos_.save_batch(batch);
+  for (std::size_t i = 0; i < jobs.size(); ++i)
+    jobs[i]->photo = std::move(batch[i]);
+  if (!saved_ids) {
+    throw std::runtime_error(saved_ids.error());
+  }
+
+  // A re-imported file keeps its existing row; metadata went to that id.
+  for (std::size_t i = 0; i < jobs.size(); ++i)
+    jobs[i]->photo.id = (*saved_ids)[i];
+
+  // Copied, not moved: if this throws, the pipeline retries each job on its
+  // own and needs the locations again. Both writes are upserts. Pack rows
+  // go first because the manifest marks a file as done for --incremental.
+  if (packs_) {
+    std::vector<domain::models::PackedThumbnail> packed;
+    for (auto *job : jobs)
+      packed.insert(packed.end(), job->packed.begin(), job->packed.end());
+    if (auto res = packs_->record(packed); !res)
+      throw std::runtime_error(res.error());
+  }
+  if (manifest_) {
+    for (auto *job : jobs) {
+      if (!job->manifest_entry)
+        continue;
+      job->manifest_entry->photo_id = job->photo.id;
+      if (auto res = manifest_->record(*job->manifest_entry); !res)
+        throw std::runtime_error(res.error());
+    }
+  }
+  for (auto *job : jobs)
+    job->packed.clear();
+
+  // Stored for good: duplicates may point at these thumbnails from now on.
+  for (auto *job : jobs) {
+    if (!job->shared_derivatives && job->photo.content_hash)
+      duplicates_.publish(*job->photo.content_hash,
+                          {own_thumb_path(*job), job->photo.width,
+                           job->photo.height});
+  }
+}
+
+void PhotoProcessor::abandon(PhotoJob &job) {
+  if (!job.shared_derivatives && job.photo.content_hash)
+    duplicates_.release(*job.photo.content_hash, own_thumb_path(job));
+}
+
+std::string PhotoProcessor::own_thumb_path(const PhotoJob &job) {
+  return fs::relative(job.file_path, job.base_path)
+      .replace_extension(".webp")
+      .string();
+}
+
+} // namespace importer
@@ -0,0 +1,231 @@
+/**
+ * SPDX-FileComment: Per-photo import stages
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file photo_processor.hpp
+ * @brief Read, metadata, derivative and persist stages for a single photo
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include "derivative_generator.hpp"
+#include "domain/interfaces/i_photo_repository.hpp"
+#include "domain/models/photo_models.hpp"
+#include "duplicate_index.hpp"
+#include "file_buffer.hpp"
+#include "header_reader.hpp"
+#include "image_engine.hpp"
+#include "import_metrics.hpp"
+#include "import_manifest.hpp"
+#include "location_cache.hpp"
+#include "thumb_pack.hpp"
+#include "webp_encoder.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace importer {
+
+/**
+ * @struct PhotoJob
+ * @brief State of one photo while it travels through the pipeline stages.
+ */
+struct PhotoJob {
+  std::filesystem::path base_path;
+  std::filesystem::path file_path;
+  std::optional<std::int64_t> queue_id; ///< import_jobs row (worker mode).
+  domain::models::Photo photo;
+  FileBuffer source; ///< Original bytes, released after metadata.
+  /// The engine's decoded original, released after derivatives.
+  std::unique_ptr<DecodedImage> decoded;
+  std::optional<HeaderInfo> header; ///< Parsed by the read stage.
+  std::size_t reserved_bytes = 0; ///< Held in the decode memory budget.
+  /// Set when the photo can never fit the memory budget; read() fails the
+  /// job with this message instead of decoding.
+  std::string over_budget;
+  /// Reuses another photo's thumbnails (byte-identical original).
+  bool shared_derivatives = false;
+  /// File state to record once persisted (incremental mode only).
+  std::optional<domain::models::ManifestEntry> manifest_entry;
+  /// Pack locations to record once persisted (pack store only).
+  std::vector<domain::models::PackedThumbnail> packed;
+};
+
+/**
+ * @struct ProcessorOptions
+ * @brief Tunables of the per-photo stages.
+ */
+struct ProcessorOptions {
+  ResizeMode resize_mode = ResizeMode::Cascade;
+  /// Let libjpeg decode JPEGs at 1/2, 1/4 or 1/8 scale when that still
+  /// covers the largest derivative.
+  bool shrink_on_load = true;
+  /// Bounding-box edge lengths of the thumbnails.
+  std::vector<int> thumb_sizes = {480, 680, 800, 1024, 1280};
+  /// Directory receiving <size>/<relative path>.webp.
+  std::filesystem::path thumb_root = "/data/thumbs";
+  /// Capture every EXIF/IPTC/XMP tag via Exiv2; otherwise only the fields
+  /// the header reader understands are stored.
+  bool full_metadata = true;
+  /// Render thumbnails from the embedded camera preview where it is large
+  /// enough, skipping the full decode when it covers every size.
+  bool use_previews = true;
+  /// Re-extract metadata for photos already stored: read only the metadata
+  /// blocks, never decode pixels or touch thumbnails, and replace the
+  /// metadata rows and tags instead of the photo rows.
+  bool metadata_only = false;
+  /// Library doing the decode and resize work.
+  ImageEngineKind engine = ImageEngineKind::Magick;
+  EncoderBackend encoder = EncoderBackend::LibWebP;
+  WebpSettings webp;
+};
+
+/**
+ * @class PhotoProcessor
+ * @brief Implements the individual import stages for a PhotoJob.
+ *
+ * Every stage is safe to call concurrently for different jobs. Stages throw
+ * std::exception on failure; the pipeline reports the error and drops the
+ * job.
+ */
+class PhotoProcessor {
+public:
+  /**
+   * @param photos Photo repository used by the persist stage.
+   * @param locations Location resolver used by the persist stage.
+   * @param options Stage tunables.
+   * @param manifest Loaded manifest; enables skipping unchanged files.
+   * @param metrics Receives per-stage timings when set.
+   * @param packs Appends thumbnails to pack files instead of writing one
+   * file per size when set.
+   * @throws std::runtime_error if options.engine is not part of this build.
+   */
+  PhotoProcessor(domain::interfaces::IPhotoRepository &photos,
+                 LocationCache &locations, ProcessorOptions options = {},
+                 ImportManifest *manifest = nullptr,
+                 ImportMetrics *metrics = nullptr,
+                 ThumbPackStore *packs = nullptr);
+
+  /**
+   * @brief One-time codec setup, must run before any worker thread starts.
+   * @param argv0 Program path, used by ImageMagick to locate its modules.
+   */
+  static void init_codecs(const char *argv0);
+
+  /**
+   * @brief Caps ImageMagick's heap and memory-mapped pixel cache; larger
+   * images spill to its disk cache instead of growing the process.
+   * @param bytes Limit in bytes, 0 leaves ImageMagick's defaults.
+   */
+  static void limit_memory(std::size_t bytes);
+
+  /**
+   * @brief Per-thread setup, run on every pipeline worker thread.
+   * @param index Worker index within the pool.
+   */
+  static void init_worker_thread(std::size_t index);
+
+  /**
+   * @brief Upper bound of the memory a photo needs between read and the
+   * end of the derivative stage, as estimated by the engine.
+   * @param header Dimensions from the file header; std::nullopt if unknown.
+   * @param file_size Size of the original in bytes.
+   */
+  std::size_t estimate_memory(const std::optional<HeaderInfo> &header,
+                              std::size_t file_size) const;
+
+  /**
+   * @brief Decodes the original image with the selected engine (see
+   * IImageEngine::decode()) and records the original's dimensions.
+   * @return false if the file is unchanged since the last import and the
+   * job needs no further stages.
+   */
+  bool read(PhotoJob &job);
+
+  /**
+   * @brief Reads EXIF/IPTC/XMP (or just the header fields when
+   * full_metadata is off) and resolves the capture date.
+   */
+  void extract_metadata(PhotoJob &job);
+
+  /**
+   * @brief Writes the WebP thumbnails (or appends them to their packs) and
+   * sets the photo's thumb_path.
+   * Does nothing for photos sharing another original's derivatives.
+   */
+  void render_derivatives(PhotoJob &job);
+
+  /**
+   * @brief Re-renders selected thumbnail sizes of an imported photo,
+   * independent of the pipeline.
+   * @param file The original.
+   * @param thumb_path Thumbnail path relative to each size directory.
+   * @param sizes Sizes to write; others are left alone.
+   * @param sources Sizes already on disk. The smallest one covering every
+   * requested size is decoded instead of the original (file store only).
+   */
+  void render_sizes(const std::filesystem::path &file,
+                    const std::string &thumb_path,
+                    const std::vector<int> &sizes,
+                    const std::vector<int> &sources = {});
+
+  /// Thumbnail box sizes, largest first.
+  const std::vector<int> &thumbnail_sizes() const {
+    return derivatives_.sizes();
+  }
+  const std::filesystem::path &thumb_root() const {
+    return options_.thumb_root;
+  }
+  /// Pack store receiving the thumbnails; nullptr for the size directories.
+  ThumbPackStore *thumb_packs() const { return packs_; }
+
+  /**
+   * @brief Resolves locations and stores photos, metadata and tags of a
+   * batch in one transaction.
+   */
+  void persist(const std::vector<PhotoJob *> &jobs);
+
+  /**
+   * @brief Cleans up after a job failed in any stage: gives up its claim
+   * on the content hash so a duplicate can render the thumbnails instead.
+   */
+  void abandon(PhotoJob &job);
+
+private:
+  /// Exiv2 path: every EXIF/IPTC/XMP tag plus keywords as tags.
+  void read_full_metadata(PhotoJob &job);
+  /// Header-reader path: camera, dates, orientation and GPS only.
+  static void apply_header(domain::models::Photo &photo,
+                           const HeaderInfo &header);
+  /// Thumbnail path the job renders to when it owns its content hash.
+  static std::string own_thumb_path(const PhotoJob &job);
+  LatencyHistogram *timing(Stage stage) const {
+    return metrics_ ? &metrics_->stage(stage) : nullptr;
+  }
+
+  domain::interfaces::IPhotoRepository &photos_;
+  LocationCache &locations_;
+  ProcessorOptions options_;
+  DerivativeGenerator derivatives_;
+  std::unique_ptr<IImageEngine> engine_;
+  WebpEncoder encoder_;
+  DuplicateIndex duplicates_;
+  ImportManifest *manifest_;
+  ImportMetrics *metrics_;
+  ThumbPackStore *packs_;
+};
+
+} // namespace importer
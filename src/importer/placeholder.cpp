@@ -0,0 +1,225 @@
+/**
+ * SPDX-FileComment: Low-quality image placeholders implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file placeholder.cpp
+ * @brief BlurHash and average color computed from a thumbnail
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "placeholder.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <format>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+namespace importer {
+
+namespace {
+
+constexpr std::string_view kBase83 = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                                     "abcdefghijklmnopqrstuvwxyz#$%*+,-.:;=?@["
+                                     "]^_{|}~";
+
+void append_base83(std::string &out, int value, int length) {
+  int divisor = 1;
+  for (int i = 1; i < length; ++i)
+    divisor *= 83;
+  for (int i = 0; i < length; ++i) {
+    out += kBase83[(value / divisor) % 83];
+    divisor /= 83;
+  }
+}
+
+// sRGB <-> linear via a lookup table for the 256 input values.
+const std::array<float, 256> &srgb_to_linear_table() {
+  static const auto table = [] {
+    std::array<float, 256> t{};
+    for (int i = 0; i < 256; ++i) {
+      const float v = static_cast<float>(i) / 255.0f;
+      t[i] = v <= 0.04045f ? v / 12.92f
+                           : std::pow((v + 0.055f) / 1.055f, 2.4f);
+    }
+    return t;
+  }();
+  return table;
+}
+
+int linear_to_srgb(float value) {
+  const float v = std::clamp(value, 0.0f, 1.0f);
+  const float s = v <= 0.0031308f ? v * 12.92f
+                                  : 1.055f * std::pow(v, 1.0f / 2.4f) - 0.055f;
+  return static_cast<int>(s * 255.0f + 0.5f);
+}
+
+float sign_pow(float value, float exp) {
+  return std::copysign(std::pow(std::fabs(value), exp), value);
+}
+
+} // namespace
+
+std::string encode_blurhash(const std::uint8_t *rgb, std::size_t width,
+                            std::size_t height, std::size_t stride,
+                            int components_x, int components_y) {
+  if (components_x < 1 || components_x > 9 || components_y < 1 ||
+      components_y > 9)
+    throw std::invalid_argument("BlurHash components must be 1-9");
+  if (width == 0 || height == 0)
+    throw std::invalid_argument("BlurHash of an empty image");
+
+  const auto &to_linear = srgb_to_linear_table();
+
+  // The basis is separable: cos(pi*i*x/w) * cos(pi*j*y/h).
+  std::vector<float> cos_x(components_x * width);
+  for (int i = 0; i < components_x; ++i)
+    for (std::size_t x = 0; x < width; ++x)
+      cos_x[i * width + x] = std::cos(std::numbers::pi_v<float> *
+                                      static_cast<float>(i * x) /
+                                      static_cast<float>(width));
+  std::vector<float> cos_y(components_y * height);
+  for (int j = 0; j < components_y; ++j)
+    for (std::size_t y = 0; y < height; ++y)
+      cos_y[j * height + y] = std::cos(std::numbers::pi_v<float> *
+                                       static_cast<float>(j * y) /
+                                       static_cast<float>(height));
+
+  const std::size_t count = components_x * components_y;
+  std::vector<std::array<float, 3>> factors(count, {0, 0, 0});
+  std::vector<std::array<float, 3>> row(components_x);
+  for (std::size_t y = 0; y < height; ++y) {
+    // Sum the row against every horizontal basis first, then weight by the
+    // vertical ones: O(w*cx + cx*cy) per row instead of O(w*cx*cy).
+    std::fill(row.begin(), row.end(), std::array<float, 3>{0, 0, 0});
+    const std::uint8_t *px = rgb + y * stride;
+    for (std::size_t x = 0; x < width; ++x, px += 3) {
+      const float r = to_linear[px[0]];
+      const float g = to_linear[px[1]];
+      const float b = to_linear[px[2]];
+      for (int i = 0; i < components_x; ++i) {
+        const float c = cos_x[i * width + x];
+        row[i][0] += c * r;
+        row[i][1] += c * g;
+        row[i][2] += c * b;
+      }
+    }
+    for (int j = 0; j < components_y; ++j) {
+      const float c = cos_y[j * height + y];
+      for (int i = 0; i < components_x; ++i) {
+        auto &f = factors[j * components_x + i];
+        f[0] += c * row[i][0];
+        f[1] += c * row[i][1];
+        f[2] += c * row[i][2];
+      }
+    }
+  }
+
+  const float pixels = static_cast<float>(width * height);
+  for (std::size_t k = 0; k < count; ++k) {
+    const float scale = (k == 0 ? 1.0f : 2.0f) / pixels;
+    for (auto &channel : factors[k])
+      channel *= scale;
+  }
+
+  std::string hash;
+  hash.reserve(4 + 2 * count);
+  append_base83(hash, (components_x - 1) + (components_y - 1) * 9, 1);
+
+  float maximum = 1.0f;
+  if (count > 1) {
+    float actual = 0.0f;
+    for (std::size_t k = 1; k < count; ++k)
+      for (float channel : factors[k])
+        actual = std::max(actual, std::fabs(channel));
+    const int quantised = std::clamp(
+        static_cast<int>(std::floor(actual * 166.0f - 0.5f)), 0, 82);
+    maximum = static_cast<float>(quantised + 1) / 166.0f;
+    append_base83(hash, quantised, 1);
+  } else {
+    append_base83(hash, 0, 1);
+  }
+
+  const auto &dc = factors[0];
+  append_base83(hash,
+                (linear_to_srgb(dc[0]) << 16) + (linear_to_srgb(dc[1]) << 8) +
+                    linear_to_srgb(dc[2]),
+                4);
+
+  for (std::size_t k = 1; k < count; ++k) {
+    auto quant = [&](float value) {
+      return std::clamp(static_cast<int>(std::floor(
+                            sign_pow(value / maximum, 0.5f) * 9.0f + 9.5f)),
+                        0, 18);
+    };
+    const auto &f = factors[k];
+    append_base83(hash, quant(f[0]) * 19 * 19 + quant(f[1]) * 19 + quant(f[2]),
+                  2);
+  }
+  return hash;
+}
+
+Placeholder compute_placeholder(const Raster &image) {
+  const std::size_t edge = std::max(image.width, image.height);
+  if (edge == 0)
+    throw std::runtime_error("Cannot compute a placeholder of an empty image");
+  auto fit = [edge](std::size_t n) {
+    return edge <= 64 ? n
+                      : std::max<std::size_t>(1, (n * 64 + edge / 2) / edge);
+  };
+  const std::size_t width = fit(image.width);
+  const std::size_t height = fit(image.height);
+
+  // Box filter: every output pixel averages the source pixels it covers.
+  std::vector<std::uint8_t> rgb(width * height * 3);
+  for (std::size_t y = 0; y < height; ++y) {
+    const std::size_t y0 = y * image.height / height;
+    const std::size_t y1 = std::max(y0 + 1, (y + 1) * image.height / height);
+    for (std::size_t x = 0; x < width; ++x) {
+      const std::size_t x0 = x * image.width / width;
+      const std::size_t x1 = std::max(x0 + 1, (x + 1) * image.width / width);
+      std::array<std::size_t, 3> sum{0, 0, 0};
+      for (std::size_t sy = y0; sy < y1; ++sy) {
+        const auto *row = image.rgba.data() + (sy * image.width + x0) * 4;
+        for (std::size_t sx = x0; sx < x1; ++sx, row += 4)
+          for (std::size_t c = 0; c < 3; ++c)
+            sum[c] += row[c];
+      }
+      const std::size_t count = (y1 - y0) * (x1 - x0);
+      for (std::size_t c = 0; c < 3; ++c)
+        rgb[(y * width + x) * 3 + c] =
+            static_cast<std::uint8_t>((sum[c] + count / 2) / count);
+    }
+  }
+
+  // 4x3 components is the usual choice for landscape grid cells; portrait
+  // photos get the transposed layout.
+  const bool portrait = height > width;
+  Placeholder placeholder;
+  placeholder.blurhash = encode_blurhash(rgb.data(), width, height, width * 3,
+                                         portrait ? 3 : 4, portrait ? 4 : 3);
+
+  // The DC component is the linear-light average; reuse it for the color.
+  const auto &to_linear = srgb_to_linear_table();
+  std::array<float, 3> sum{0, 0, 0};
+  for (std::size_t p = 0; p < rgb.size(); p += 3)
+    for (int c = 0; c < 3; ++c)
+      sum[c] += to_linear[rgb[p + c]];
+  const float n = static_cast<float>(width * height);
+  placeholder.color =
+      std::format("#{:02x}{:02x}{:02x}", linear_to_srgb(sum[0] / n),
+                  linear_to_srgb(sum[1] / n), linear_to_srgb(sum[2] / n));
+  return placeholder;
+}
+
+} // namespace importer
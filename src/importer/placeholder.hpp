@@ -0,0 +1,54 @@
+/**
+ * SPDX-FileComment: Low-quality image placeholders
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file placeholder.hpp
+ * @brief BlurHash and average color computed from a thumbnail
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include "image_engine.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace importer {
+
+/**
+ * @struct Placeholder
+ * @brief What the frontend paints before the first thumbnail byte arrives.
+ */
+struct Placeholder {
+  std::string blurhash; ///< BlurHash string (see blurha.sh).
+  std::string color;    ///< Average color as "#rrggbb".
+};
+
+/**
+ * @brief Encodes packed 8-bit RGB pixels as a BlurHash.
+ * @param components_x Horizontal components, 1-9.
+ * @param components_y Vertical components, 1-9.
+ */
+std::string encode_blurhash(const std::uint8_t *rgb, std::size_t width,
+                            std::size_t height, std::size_t stride,
+                            int components_x, int components_y);
+
+/**
+ * @brief Computes the placeholder of an already downscaled image.
+ *
+ * The image is box-scaled to at most 64 pixels per side first; BlurHash
+ * keeps only a handful of cosine components, so more input only costs time.
+ */
+Placeholder compute_placeholder(const Raster &image);
+
+} // namespace importer
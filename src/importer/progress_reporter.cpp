@@ -0,0 +1,81 @@
+/**
+ * SPDX-FileComment: Periodic JSON progress lines for the importer implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file progress_reporter.cpp
+ * @brief Writes throughput, ETA and queue depths as JSON lines
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "progress_reporter.hpp"
+#include <format>
+#include <print>
+
+namespace importer {
+
+ProgressReporter::ProgressReporter(const ImportPipeline &pipeline,
+                                   std::FILE *out,
+                                   std::chrono::milliseconds interval)
+    : pipeline_(pipeline), out_(out), interval_(interval),
+      start_(std::chrono::steady_clock::now()) {
+  thread_ = std::thread([this] {
+    std::unique_lock lock(mutex_);
+    while (!cv_.wait_for(lock, interval_, [this] { return stopping_; })) {
+      lock.unlock();
+      write_line("progress");
+      lock.lock();
+    }
+  });
+}
+
+ProgressReporter::~ProgressReporter() {
+  {
+    std::lock_guard lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  if (thread_.joinable())
+    thread_.join();
+  write_line("done");
+}
+
+void ProgressReporter::write_line(const char *event) {
+  const auto &stats = pipeline_.stats();
+  const auto depths = pipeline_.depths();
+  const double elapsed = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start_)
+                             .count();
+
+  const auto submitted = stats.submitted.load();
+  const auto done =
+      stats.imported.load() + stats.skipped.load() + stats.failed.load();
+  const double rate = elapsed > 0 ? static_cast<double>(done) / elapsed : 0.0;
+
+  std::string eta = "null";
+  if (scan_complete_.load() && rate > 0 && submitted >= done)
+    eta = std::format("{:.1f}", static_cast<double>(submitted - done) / rate);
+
+  std::println(out_,
+               "{{\"event\":\"{}\",\"elapsed_s\":{:.1f},\"submitted\":{},"
+               "\"imported\":{},\"skipped\":{},\"failed\":{},"
+               "\"photos_per_s\":{:.1f},\"eta_s\":{},\"bytes_read\":{},"
+               "\"queues\":{{\"scan\":{},\"pool\":{},\"persist\":{},"
+               "\"in_flight\":{}}},\"scan_complete\":{}}}",
+               event, elapsed, submitted, stats.imported.load(),
+               stats.skipped.load(), stats.failed.load(), rate, eta,
+               stats.bytes_read.load(), depths.scan_queue, depths.pool_queue,
+               depths.persist_queue, depths.in_flight,
+               scan_complete_.load() ? "true" : "false");
+  std::fflush(out_);
+}
+
+} // namespace importer
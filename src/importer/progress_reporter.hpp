@@ -0,0 +1,76 @@
+/**
+ * SPDX-FileComment: Periodic JSON progress lines for the importer
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file progress_reporter.hpp
+ * @brief Writes throughput, ETA and queue depths as JSON lines
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include "import_pipeline.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+namespace importer {
+
+/**
+ * @class ProgressReporter
+ * @brief Background thread printing one JSON object per interval.
+ *
+ * Example line:
+ * {"event":"progress","elapsed_s":12.0,"submitted":5000,"imported":1210,
+ *  "skipped":0,"failed":2,"photos_per_s":101.0,"eta_s":37.4,
+ *  "bytes_read":4521337856,"queues":{"scan":3778,"pool":14,"persist":3,
+ *  "in_flight":32},"scan_complete":true}
+ *
+ * eta_s is null until the scan has finished, since the total is unknown.
+ */
+class ProgressReporter {
+public:
+  ProgressReporter(const ImportPipeline &pipeline, std::FILE *out,
+                   std::chrono::milliseconds interval);
+
+  /**
+   * @brief Stops the thread and writes a final line ("event":"done").
+   */
+  ~ProgressReporter();
+
+  ProgressReporter(const ProgressReporter &) = delete;
+  ProgressReporter &operator=(const ProgressReporter &) = delete;
+
+  /**
+   * @brief All files have been submitted; enables the ETA.
+   */
+  void mark_scan_complete() { scan_complete_.store(true); }
+
+private:
+  void write_line(const char *event);
+
+  const ImportPipeline &pipeline_;
+  std::FILE *out_;
+  std::chrono::milliseconds interval_;
+  std::chrono::steady_clock::time_point start_;
+  std::atomic<bool> scan_complete_{false};
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopping_ = false;
+  std::thread thread_;
+};
+
+} // namespace importer
@@ -0,0 +1,412 @@
+/**
+ * SPDX-FileComment: Database/filesystem reconciliation implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file reconciler.cpp
+ * @brief Removes stale photos and orphaned thumbnails, fills in missing ones
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "reconciler.hpp"
+#include "directory_scanner.hpp"
+#include "work_stealing_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <format>
+#include <future>
+#include <iterator>
+#include <mutex>
+#include <print>
+#include <unordered_map>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+namespace importer {
+
+namespace {
+
+/**
+ * @brief Lists the regular files below @p dir, sorted.
+ * @param relative Return paths relative to @p dir instead of full paths.
+ * @param photos_only Keep only files the importer accepts.
+ */
+std::expected<std::vector<std::string>, std::string>
+list_files(const fs::path &dir, bool relative, bool photos_only) {
+  std::vector<std::string> files;
+  std::error_code ec;
+  if (!fs::exists(dir, ec))
+    return files;
+
+  std::mutex mutex;
+  ScanOptions options;
+  options.photos_only = photos_only;
+  std::size_t strip = 0;
+  auto scanned = scan_tree(
+      dir,
+      [&](std::string &&path) {
+        std::lock_guard lock(mutex);
+        files.push_back(std::move(path));
+        if (relative && strip == 0)
+          strip = files.back().size() - fs::path(files.back())
+                                            .lexically_relative(dir)
+                                            .native()
+                                            .size();
+      },
+      options);
+  if (!scanned)
+    return std::unexpected(scanned.error());
+  if (relative) {
+    // Every path starts with the same "<dir>/" prefix.
+    for (auto &file : files)
+      file.erase(0, strip);
+  }
+  std::ranges::sort(files);
+  return files;
+}
+
+/**
+ * @brief Walks two sorted ranges and reports the elements only in one.
+ */
+template <typename Left, typename Right, typename KeyL, typename KeyR,
+          typename OnlyLeft, typename OnlyRight>
+void merge_difference(const Left &left, const Right &right, KeyL key_left,
+                      KeyR key_right, OnlyLeft only_left,
+                      OnlyRight only_right) {
+  auto l = left.begin();
+  auto r = right.begin();
+  while (l != left.end() || r != right.end()) {
+    if (r == right.end() ||
+        (l != left.end() && key_left(*l) < key_right(*r))) {
+      only_left(*l++);
+    } else if (l == left.end() || key_right(*r) < key_left(*l)) {
+      only_right(*r++);
+    } else {
+      ++l;
+      ++r;
+    }
+  }
+}
+
+
+/**
+ * @struct Reference
+ * @brief A thumbnail path still referenced by a row, with the original to
+ * render it from.
+ */
+struct Reference {
+  std::string thumb;
+  std::string file;
+  bool owner; ///< The file the thumbnails were rendered for.
+};
+
+using Listing = std::expected<std::vector<std::string>, std::string>;
+
+/**
+ * @brief Rows below @p root; in byte order they form one contiguous range.
+ * @param rows Sorted by file_path.
+ */
+auto rows_below(std::vector<domain::models::PhotoPaths> &rows,
+                const fs::path &root) {
+  const auto prefix = (root / "").string();
+  auto first = std::ranges::lower_bound(rows, prefix, {},
+                                        &domain::models::PhotoPaths::file_path);
+  auto last = std::find_if(first, rows.end(), [&](const auto &row) {
+    return !row.file_path.starts_with(prefix);
+  });
+  return std::ranges::subrange(first, last);
+}
+
+/**
+ * @brief Thumbnails referenced by @p rows, sorted by path. Where duplicates
+ * share thumbnails, the photo that rendered them wins.
+ * @param rows Sorted by file_path.
+ * @param skip Sorted file paths whose rows are ignored.
+ */
+template <typename Rows>
+std::vector<Reference> collect_references(const Rows &rows,
+                                          const std::vector<std::string> &skip) {
+  std::vector<Reference> referenced;
+  std::size_t s = 0;
+  for (const auto &row : rows) {
+    while (s < skip.size() && skip[s] < row.file_path)
+      ++s;
+    if (s < skip.size() && skip[s] == row.file_path)
+      continue;
+    if (!row.thumb_path || row.thumb_path->empty())
+      continue;
+    const bool owner = fs::path(row.file_path)
+                           .replace_extension(".webp")
+                           .string()
+                           .ends_with("/" + *row.thumb_path);
+    referenced.push_back({*row.thumb_path, row.file_path, owner});
+  }
+  std::ranges::sort(referenced, [](const Reference &a, const Reference &b) {
+    if (a.thumb != b.thumb)
+      return a.thumb < b.thumb;
+    return a.owner > b.owner;
+  });
+  auto dup = std::ranges::unique(referenced, {}, &Reference::thumb);
+  referenced.erase(dup.begin(), dup.end());
+  return referenced;
+}
+
+/**
+ * @brief Starts listing the thumbnails of every size, as paths relative to
+ * the size directory: the files below it, or the pack index entries.
+ */
+std::vector<std::future<Listing>>
+list_thumbnails(const PhotoProcessor &processor) {
+  std::vector<std::future<Listing>> futures;
+  for (int size : processor.thumbnail_sizes()) {
+    futures.push_back(
+        std::async(std::launch::async, [&processor, size]() -> Listing {
+          if (auto *packs = processor.thumb_packs())
+            return packs->list(size);
+          return list_files(processor.thumb_root() / std::to_string(size),
+                            true, false);
+        }));
+  }
+  return futures;
+}
+
+/**
+ * @brief Renders the missing sizes of every reference in parallel. The
+ * sizes a photo still has are offered as sources, so a new small size
+ * comes from an existing thumbnail instead of the original.
+ * @param missing Sizes to render per index into @p referenced.
+ */
+void render_missing(PhotoProcessor &processor, const ReconcileOptions &options,
+                    const std::vector<Reference> &referenced,
+                    std::unordered_map<std::size_t, std::vector<int>> &missing,
+                    ReconcileReport &report) {
+  const auto &sizes = processor.thumbnail_sizes();
+  std::atomic<std::size_t> regenerated{0};
+  std::atomic<std::size_t> failed{0};
+  {
+    WorkStealingPool pool(options.jobs);
+    for (auto &[idx, missing_sizes] : missing) {
+      pool.submit([&, idx = idx, missing_sizes = std::move(missing_sizes)] {
+        const auto &file = referenced[idx].file;
+        std::vector<int> present;
+        std::ranges::copy_if(sizes, std::back_inserter(present), [&](int s) {
+          return std::ranges::find(missing_sizes, s) == missing_sizes.end();
+        });
+        try {
+          processor.render_sizes(file, referenced[idx].thumb, missing_sizes,
+                                 present);
+          regenerated.fetch_add(1);
+          if (options.log_each_file)
+            std::println("  ✓ {} ({} sizes)", file, missing_sizes.size());
+        } catch (const std::exception &e) {
+          failed.fetch_add(1);
+          std::println(stderr, "  ✗ Error rendering {}: {}", file, e.what());
+        }
+      });
+    }
+    pool.wait_idle();
+  }
+  report.regenerated += regenerated.load();
+  report.failed += failed.load();
+}
+
+} // namespace
+
+Reconciler::Reconciler(domain::interfaces::IPhotoRepository &photos,
+                       PhotoProcessor &processor, ReconcileOptions options)
+    : photos_(photos), processor_(processor), options_(options) {}
+
+std::expected<ReconcileReport, std::string> Reconciler::run(
+    const fs::path &root,
+    const std::function<void(const fs::path &)> &import_file) {
+  ReconcileReport report;
+  const auto &sizes = processor_.thumbnail_sizes();
+  const auto &thumb_root = processor_.thumb_root();
+  auto *packs = processor_.thumb_packs();
+
+  // 1. List originals, rows and every thumbnail size (the files, or the
+  // pack index) concurrently.
+  auto files_future = std::async(std::launch::async, [&] {
+    return list_files(root, false, true);
+  });
+  auto thumb_futures = list_thumbnails(processor_);
+  auto rows = photos_.list_paths();
+  if (!rows)
+    return std::unexpected(rows.error());
+  std::ranges::sort(*rows, {}, &domain::models::PhotoPaths::file_path);
+
+  auto files = files_future.get();
+  if (!files)
+    return std::unexpected(files.error());
+  report.files = files->size();
+  report.rows = rows->size();
+
+  // 2. Originals vs. rows. Only rows below root can be judged.
+  auto scoped = rows_below(*rows, root);
+
+  std::vector<std::string> stale;
+  std::vector<std::string> added;
+  merge_difference(
+      *files, scoped, [](const std::string &f) -> const std::string & {
+        return f;
+      },
+      [](const auto &row) -> const std::string & { return row.file_path; },
+      [&](const std::string &file) { added.push_back(file); },
+      [&](const auto &row) { stale.push_back(row.file_path); });
+  report.stale_rows = stale.size();
+  report.new_files = added.size();
+
+  for (std::size_t i = 0; i < stale.size(); i += options_.delete_batch) {
+    std::vector<std::string> batch(
+        stale.begin() + static_cast<std::ptrdiff_t>(i),
+        stale.begin() + static_cast<std::ptrdiff_t>(
+                            std::min(stale.size(), i + options_.delete_batch)));
+    if (options_.log_each_file) {
+      for (const auto &path : batch)
+        std::println("  - {}", path);
+    }
+    if (options_.dry_run)
+      continue;
+    if (auto res = photos_.remove_paths(batch); !res) {
+      std::println(stderr, "  ✗ Error removing stale rows: {}", res.error());
+      report.failed += batch.size();
+    }
+  }
+
+  // New files are imported last: the thumbnail listings and the orphan
+  // check below work from the rows read above, so a thumbnail the pipeline
+  // writes meanwhile would look orphaned and be deleted.
+  auto import_added = [&] {
+    if (!options_.dry_run) {
+      for (const auto &file : added)
+        import_file(file);
+    } else if (options_.log_each_file) {
+      for (const auto &file : added)
+        std::println("  + {}", file);
+    }
+  };
+
+  // 3. Thumbnails still referenced by any row, each with the original to
+  // render it from.
+  auto referenced = collect_references(*rows, stale);
+
+  // 4. Per size: delete what nobody refers to, note what is missing.
+  std::unordered_map<std::size_t, std::vector<int>> missing; // referenced idx
+  for (std::size_t k = 0; k < sizes.size(); ++k) {
+    auto thumbs = thumb_futures[k].get();
+    if (!thumbs)
+      return std::unexpected(thumbs.error());
+    report.thumbnails += thumbs->size();
+    const auto size_dir = thumb_root / std::to_string(sizes[k]);
+    std::vector<std::string> unpacked; // Orphaned pack index entries.
+
+    merge_difference(
+        referenced, *thumbs,
+        [](const Reference &ref) -> const std::string & { return ref.thumb; },
+        [](const std::string &t) -> const std::string & { return t; },
+        [&](const Reference &ref) {
+          ++report.missing;
+          missing[static_cast<std::size_t>(&ref - referenced.data())]
+              .push_back(sizes[k]);
+        },
+        [&](const std::string &orphan) {
+          ++report.orphans;
+          if (packs) {
+            if (options_.log_each_file)
+              std::println("  - {} in {}", orphan,
+                           (thumb_root /
+                            ThumbPackStore::pack_path(orphan, sizes[k]))
+                               .string());
+            unpacked.push_back(orphan);
+            return;
+          }
+          if (options_.log_each_file)
+            std::println("  - {}", (size_dir / orphan).string());
+          if (options_.dry_run)
+            return;
+          std::error_code ec;
+          if (!fs::remove(size_dir / orphan, ec) && ec) {
+            std::println(stderr, "  ✗ Error removing {}: {}",
+                         (size_dir / orphan).string(), ec.message());
+            ++report.failed;
+          }
+        });
+
+    for (std::size_t i = 0; !options_.dry_run && i < unpacked.size();
+         i += options_.delete_batch) {
+      std::vector<std::string> batch(
+          unpacked.begin() + static_cast<std::ptrdiff_t>(i),
+          unpacked.begin() +
+              static_cast<std::ptrdiff_t>(
+                  std::min(unpacked.size(), i + options_.delete_batch)));
+      if (auto res = packs->remove(sizes[k], batch); !res) {
+        std::println(stderr, "  ✗ Error removing pack entries: {}",
+                     res.error());
+        report.failed += batch.size();
+      }
+    }
+  }
+
+  // 5. Render only the missing sizes, in parallel.
+  if (!options_.dry_run && !missing.empty())
+    render_missing(processor_, options_, referenced, missing, report);
+  import_added();
+  return report;
+}
+
+std::expected<ReconcileReport, std::string>
+Reconciler::regenerate(const fs::path &root) {
+  ReconcileReport report;
+  const auto &sizes = processor_.thumbnail_sizes();
+
+  auto thumb_futures = list_thumbnails(processor_);
+  auto rows = photos_.list_paths();
+  if (!rows)
+    return std::unexpected(rows.error());
+  std::ranges::sort(*rows, {}, &domain::models::PhotoPaths::file_path);
+  auto scoped = rows_below(*rows, root);
+  report.rows = scoped.size();
+  auto referenced = collect_references(scoped, {});
+
+  // Extra files in the size directories are reconcile's business.
+  std::unordered_map<std::size_t, std::vector<int>> missing; // referenced idx
+  for (std::size_t k = 0; k < sizes.size(); ++k) {
+    auto thumbs = thumb_futures[k].get();
+    if (!thumbs)
+      return std::unexpected(thumbs.error());
+    report.thumbnails += thumbs->size();
+    merge_difference(
+        referenced, *thumbs,
+        [](const Reference &ref) -> const std::string & { return ref.thumb; },
+        [](const std::string &t) -> const std::string & { return t; },
+        [&](const Reference &ref) {
+          ++report.missing;
+          missing[static_cast<std::size_t>(&ref - referenced.data())]
+              .push_back(sizes[k]);
+        },
+        [](const std::string &) {});
+  }
+
+  if (options_.dry_run) {
+    if (options_.log_each_file) {
+      for (const auto &[idx, missing_sizes] : missing)
+        std::println("  + {} ({} sizes)", referenced[idx].file,
+                     missing_sizes.size());
+    }
+    return report;
+  }
+  if (!missing.empty())
+    render_missing(processor_, options_, referenced, missing, report);
+  return report;
+}
+
+} // namespace importer
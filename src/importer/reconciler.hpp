@@ -0,0 +1,100 @@
+/**
+ * SPDX-FileComment: Database/filesystem reconciliation
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file reconciler.hpp
+ * @brief Removes stale photos and orphaned thumbnails, fills in missing ones
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include "domain/interfaces/i_photo_repository.hpp"
+#include "photo_processor.hpp"
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <string>
+
+namespace importer {
+
+/**
+ * @struct ReconcileOptions
+ * @brief Behaviour of a reconciliation run.
+ */
+struct ReconcileOptions {
+  bool dry_run = false;     ///< Report differences without changing anything.
+  bool log_each_file = true; ///< Print a line per changed row or file.
+  std::size_t jobs = 0;     ///< Threads re-rendering thumbnails; 0 = cores.
+  std::size_t delete_batch = 1000; ///< Rows per DELETE statement.
+};
+
+/**
+ * @struct ReconcileReport
+ * @brief What a reconciliation run found (and fixed unless dry_run).
+ */
+struct ReconcileReport {
+  std::size_t files = 0;          ///< Photos found below the root.
+  std::size_t rows = 0;           ///< Photos in the database (all roots).
+  std::size_t stale_rows = 0;     ///< Rows below the root without a file.
+  std::size_t new_files = 0;      ///< Files without a row, handed to import.
+  std::size_t thumbnails = 0;     ///< Files (or pack entries) found.
+  std::size_t orphans = 0;        ///< Thumbnails no photo refers to.
+  std::size_t missing = 0;        ///< Referenced thumbnails not stored.
+  std::size_t regenerated = 0;    ///< Photos whose missing sizes were rendered.
+  std::size_t failed = 0;         ///< Deletions or renders that failed.
+};
+
+/**
+ * @class Reconciler
+ * @brief Brings the photos table and the thumbnail tree in line with the
+ * originals on disk.
+ *
+ * The original tree, the photos table and every thumbnail size directory
+ * are listed concurrently, sorted, and compared with linear merges, so the
+ * run costs one directory walk per tree and one table scan regardless of
+ * how many files differ. With the pack store the pack index stands in for
+ * the size directories: orphaned entries are deleted (their bytes stay in
+ * the pack) and missing ones are rendered into the packs.
+ */
+class Reconciler {
+public:
+  Reconciler(domain::interfaces::IPhotoRepository &photos,
+             PhotoProcessor &processor, ReconcileOptions options = {});
+
+  /**
+   * @param root Library directory; only rows below it can become stale.
+   * @param import_file Called for every file that has no row yet, once the
+   * thumbnails have been reconciled.
+   */
+  std::expected<ReconcileReport, std::string>
+  run(const std::filesystem::path &root,
+      const std::function<void(const std::filesystem::path &)> &import_file);
+
+  /**
+   * @brief Renders the sizes of the configured ladder that photos below
+   * @p root are missing, and nothing else: no rows, originals or orphaned
+   * thumbnails are touched. Each photo is rendered from the smallest
+   * thumbnail it already has that covers the missing sizes, else from the
+   * original.
+   */
+  std::expected<ReconcileReport, std::string>
+  regenerate(const std::filesystem::path &root);
+
+private:
+  domain::interfaces::IPhotoRepository &photos_;
+  PhotoProcessor &processor_;
+  ReconcileOptions options_;
+};
+
+} // namespace importer
@@ -0,0 +1,544 @@
+/**
+ * SPDX-FileComment: Separable image resampler
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file resampler.cpp
+ * @brief Lanczos/Mitchell resampling of 8-bit RGBA with SIMD inner loops
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "resampler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+#include <stdexcept>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define GALLERY_RESAMPLE_AVX2 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define GALLERY_RESAMPLE_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace importer {
+
+namespace {
+
+/// Fraction bits of the fixed-point weights. 14 keeps a pair of
+/// 255 * weight products inside the int32 of _mm256_madd_epi16.
+constexpr int kBits = 14;
+constexpr std::int32_t kOne = 1 << kBits;
+constexpr std::int32_t kHalf = 1 << (kBits - 1);
+
+double sinc(double x) {
+  if (x == 0.0)
+    return 1.0;
+  x *= std::numbers::pi;
+  return std::sin(x) / x;
+}
+
+double lanczos3(double x) {
+  x = std::fabs(x);
+  return x < 3.0 ? sinc(x) * sinc(x / 3.0) : 0.0;
+}
+
+double mitchell(double x) {
+  constexpr double B = 1.0 / 3.0;
+  constexpr double C = 1.0 / 3.0;
+  x = std::fabs(x);
+  if (x < 1.0)
+    return ((12 - 9 * B - 6 * C) * x * x * x + (-18 + 12 * B + 6 * C) * x * x +
+            (6 - 2 * B)) /
+           6;
+  if (x < 2.0)
+    return ((-B - 6 * C) * x * x * x + (6 * B + 30 * C) * x * x +
+            (-12 * B - 48 * C) * x + (8 * B + 24 * C)) /
+           6;
+  return 0.0;
+}
+
+/**
+ * @struct Coefficients
+ * @brief Source window and weights of every output pixel along one axis.
+ */
+struct Coefficients {
+  std::vector<std::uint32_t> start; ///< First source pixel.
+  std::vector<std::uint32_t> count; ///< Source pixels with a weight.
+  std::vector<std::int16_t> weights; ///< taps per output pixel, zero-padded.
+  std::size_t taps = 0;
+
+  const std::int16_t *weights_of(std::size_t i) const {
+    return weights.data() + i * taps;
+  }
+};
+
+Coefficients coefficients(std::size_t in, std::size_t out,
+                          ResampleFilter filter) {
+  const double support_1x = filter == ResampleFilter::Lanczos3 ? 3.0 : 2.0;
+  const auto kernel = filter == ResampleFilter::Lanczos3 ? lanczos3 : mitchell;
+  const double scale = static_cast<double>(in) / static_cast<double>(out);
+  // Reductions stretch the filter over the source pixels that fold into
+  // one output pixel, which is what suppresses aliasing.
+  const double stretch = std::max(scale, 1.0);
+  const double support = support_1x * stretch;
+
+  Coefficients c;
+  c.taps = static_cast<std::size_t>(std::ceil(support)) * 2 + 1;
+  c.start.resize(out);
+  c.count.resize(out);
+  c.weights.assign(out * c.taps, 0);
+
+  std::vector<double> w(c.taps);
+  for (std::size_t i = 0; i < out; ++i) {
+    const double center = (static_cast<double>(i) + 0.5) * scale;
+    const auto first = static_cast<std::ptrdiff_t>(
+        std::max(0.0, std::floor(center - support + 0.5)));
+    const auto last = static_cast<std::ptrdiff_t>(
+        std::min(static_cast<double>(in), std::floor(center + support + 0.5)));
+    const auto n = static_cast<std::size_t>(std::max<std::ptrdiff_t>(
+        1, std::min<std::ptrdiff_t>(last - first,
+                                    static_cast<std::ptrdiff_t>(c.taps))));
+
+    double sum = 0;
+    for (std::size_t k = 0; k < n; ++k) {
+      const double x = static_cast<double>(first) + static_cast<double>(k) -
+                       center + 0.5;
+      w[k] = kernel(x / stretch);
+      sum += w[k];
+    }
+
+    // Normalise and round, then put the rounding error on the largest
+    // weight so flat areas come out exactly unchanged.
+    auto *fixed = c.weights.data() + i * c.taps;
+    std::int32_t total = 0;
+    std::size_t largest = 0;
+    for (std::size_t k = 0; k < n; ++k) {
+      const double value = sum != 0.0 ? w[k] / sum : (k == 0 ? 1.0 : 0.0);
+      fixed[k] = static_cast<std::int16_t>(std::lround(value * kOne));
+      total += fixed[k];
+      if (fixed[k] > fixed[largest])
+        largest = k;
+    }
+    fixed[largest] = static_cast<std::int16_t>(fixed[largest] + kOne - total);
+    c.start[i] = static_cast<std::uint32_t>(first);
+    c.count[i] = static_cast<std::uint32_t>(n);
+  }
+  return c;
+}
+
+std::uint8_t clamp8(std::int32_t value) {
+  return static_cast<std::uint8_t>(std::clamp(value >> kBits, 0, 255));
+}
+
+// --- Scalar ---------------------------------------------------------------
+
+void horizontal_scalar(const std::uint8_t *src, std::uint8_t *dst,
+                       const Coefficients &c) {
+  for (std::size_t x = 0; x < c.start.size(); ++x) {
+    const auto *s = src + std::size_t{c.start[x]} * 4;
+    const auto *w = c.weights_of(x);
+    std::int32_t acc[4] = {kHalf, kHalf, kHalf, kHalf};
+    for (std::size_t k = 0; k < c.count[x]; ++k)
+      for (std::size_t ch = 0; ch < 4; ++ch)
+        acc[ch] += s[k * 4 + ch] * w[k];
+    for (std::size_t ch = 0; ch < 4; ++ch)
+      dst[x * 4 + ch] = clamp8(acc[ch]);
+  }
+}
+
+/// @param src First contributing row; rows are @p stride bytes apart.
+void vertical_scalar(const std::uint8_t *src, std::size_t stride,
+                     const std::int16_t *w, std::size_t count,
+                     std::uint8_t *dst, std::size_t begin, std::size_t end) {
+  for (std::size_t i = begin; i < end; ++i) {
+    std::int32_t acc = kHalf;
+    for (std::size_t k = 0; k < count; ++k)
+      acc += src[k * stride + i] * w[k];
+    dst[i] = clamp8(acc);
+  }
+}
+
+// --- AVX2 -----------------------------------------------------------------
+
+#ifdef GALLERY_RESAMPLE_AVX2
+
+/// Two int16 weights as the (lo, hi) pair _mm*_madd_epi16 multiplies.
+int weight_pair(std::int16_t lo, std::int16_t hi) {
+  return static_cast<int>(static_cast<std::uint16_t>(lo) |
+                          static_cast<std::uint32_t>(
+                              static_cast<std::uint16_t>(hi))
+                              << 16);
+}
+
+__attribute__((target("avx2"))) void
+horizontal_avx2(const std::uint8_t *src, std::uint8_t *dst,
+                const Coefficients &c) {
+  // Widened pixels p0 p1 (and p2 p3 in the upper lane) reordered to
+  // r0 r1 g0 g1 b0 b1 a0 a1, so madd sums both pixels per channel.
+  const __m256i interleave = _mm256_setr_epi8(
+      0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15, //
+      0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15);
+  const __m128i interleave128 = _mm256_castsi256_si128(interleave);
+
+  for (std::size_t x = 0; x < c.start.size(); ++x) {
+    const auto *s = src + std::size_t{c.start[x]} * 4;
+    const auto *w = c.weights_of(x);
+    const std::size_t n = c.count[x];
+
+    __m256i acc4 = _mm256_setzero_si256();
+    std::size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+      const __m128i px =
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + k * 4));
+      const __m256i v =
+          _mm256_shuffle_epi8(_mm256_cvtepu8_epi16(px), interleave);
+      const __m128i w4 =
+          _mm_loadl_epi64(reinterpret_cast<const __m128i *>(w + k));
+      const __m256i weights = _mm256_set_m128i(_mm_shuffle_epi32(w4, 0x55),
+                                               _mm_shuffle_epi32(w4, 0x00));
+      acc4 = _mm256_add_epi32(acc4, _mm256_madd_epi16(v, weights));
+    }
+    __m128i acc = _mm_add_epi32(_mm256_castsi256_si128(acc4),
+                                _mm256_extracti128_si256(acc4, 1));
+    acc = _mm_add_epi32(acc, _mm_set1_epi32(kHalf));
+    for (; k + 2 <= n; k += 2) {
+      const __m128i px =
+          _mm_loadl_epi64(reinterpret_cast<const __m128i *>(s + k * 4));
+      const __m128i v = _mm_shuffle_epi8(_mm_cvtepu8_epi16(px), interleave128);
+      acc = _mm_add_epi32(
+          acc, _mm_madd_epi16(v, _mm_set1_epi32(weight_pair(w[k], w[k + 1]))));
+    }
+    if (k < n) {
+      std::int32_t bytes;
+      std::memcpy(&bytes, s + k * 4, 4);
+      const __m128i v = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(bytes));
+      acc = _mm_add_epi32(acc, _mm_mullo_epi32(v, _mm_set1_epi32(w[k])));
+    }
+
+    acc = _mm_srai_epi32(acc, kBits);
+    acc = _mm_packs_epi32(acc, acc);
+    acc = _mm_packus_epi16(acc, acc);
+    const std::int32_t out = _mm_cvtsi128_si32(acc);
+    std::memcpy(dst + x * 4, &out, 4);
+  }
+}
+
+__attribute__((target("avx2"))) void
+vertical_avx2(const std::uint8_t *src, std::size_t stride,
+              const std::int16_t *w, std::size_t count, std::uint8_t *dst,
+              std::size_t bytes) {
+  const __m256i half = _mm256_set1_epi32(kHalf);
+  const __m128i zero = _mm_setzero_si128();
+  std::size_t i = 0;
+  for (; i + 16 <= bytes; i += 16) {
+    __m256i lo = half;
+    __m256i hi = half;
+    std::size_t k = 0;
+    // Two rows at a time: interleaved bytes make (row k, row k+1) pairs.
+    for (; k + 2 <= count; k += 2) {
+      const __m128i r0 = _mm_loadu_si128(
+          reinterpret_cast<const __m128i *>(src + k * stride + i));
+      const __m128i r1 = _mm_loadu_si128(
+          reinterpret_cast<const __m128i *>(src + (k + 1) * stride + i));
+      const __m256i pair = _mm256_set1_epi32(weight_pair(w[k], w[k + 1]));
+      lo = _mm256_add_epi32(
+          lo, _mm256_madd_epi16(
+                  _mm256_cvtepu8_epi16(_mm_unpacklo_epi8(r0, r1)), pair));
+      hi = _mm256_add_epi32(
+          hi, _mm256_madd_epi16(
+                  _mm256_cvtepu8_epi16(_mm_unpackhi_epi8(r0, r1)), pair));
+    }
+    if (k < count) {
+      const __m128i r0 = _mm_loadu_si128(
+          reinterpret_cast<const __m128i *>(src + k * stride + i));
+      const __m256i pair = _mm256_set1_epi32(weight_pair(w[k], 0));
+      lo = _mm256_add_epi32(
+          lo, _mm256_madd_epi16(
+                  _mm256_cvtepu8_epi16(_mm_unpacklo_epi8(r0, zero)), pair));
+      hi = _mm256_add_epi32(
+          hi, _mm256_madd_epi16(
+                  _mm256_cvtepu8_epi16(_mm_unpackhi_epi8(r0, zero)), pair));
+    }
+
+    lo = _mm256_srai_epi32(lo, kBits);
+    hi = _mm256_srai_epi32(hi, kBits);
+    // packs works per 128-bit lane; the permute restores byte order.
+    const __m256i packed =
+        _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xD8);
+    const __m128i out = _mm_packus_epi16(_mm256_castsi256_si128(packed),
+                                         _mm256_extracti128_si256(packed, 1));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), out);
+  }
+  vertical_scalar(src, stride, w, count, dst, i, bytes);
+}
+
+#endif // GALLERY_RESAMPLE_AVX2
+
+// --- NEON -----------------------------------------------------------------
+
+#ifdef GALLERY_RESAMPLE_NEON
+
+void horizontal_neon(const std::uint8_t *src, std::uint8_t *dst,
+                     const Coefficients &c) {
+  for (std::size_t x = 0; x < c.start.size(); ++x) {
+    const auto *s = src + std::size_t{c.start[x]} * 4;
+    const auto *w = c.weights_of(x);
+    const std::size_t n = c.count[x];
+
+    int32x4_t acc = vdupq_n_s32(0);
+    std::size_t k = 0;
+    for (; k + 2 <= n; k += 2) {
+      const int16x8_t v = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(s + k * 4)));
+      acc = vmlal_n_s16(acc, vget_low_s16(v), w[k]);
+      acc = vmlal_n_s16(acc, vget_high_s16(v), w[k + 1]);
+    }
+    if (k < n) {
+      std::uint32_t bytes;
+      std::memcpy(&bytes, s + k * 4, 4);
+      const int16x8_t v = vreinterpretq_s16_u16(
+          vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(bytes))));
+      acc = vmlal_n_s16(acc, vget_low_s16(v), w[k]);
+    }
+
+    // Rounding narrow: the same (acc + kHalf) >> kBits as the scalar path.
+    const int16x4_t narrow = vqrshrn_n_s32(acc, kBits);
+    const uint8x8_t out = vqmovun_s16(vcombine_s16(narrow, narrow));
+    const std::uint32_t pixel = vget_lane_u32(vreinterpret_u32_u8(out), 0);
+    std::memcpy(dst + x * 4, &pixel, 4);
+  }
+}
+
+void vertical_neon(const std::uint8_t *src, std::size_t stride,
+                   const std::int16_t *w, std::size_t count,
+                   std::uint8_t *dst, std::size_t bytes) {
+  std::size_t i = 0;
+  for (; i + 16 <= bytes; i += 16) {
+    int32x4_t a0 = vdupq_n_s32(0);
+    int32x4_t a1 = a0;
+    int32x4_t a2 = a0;
+    int32x4_t a3 = a0;
+    for (std::size_t k = 0; k < count; ++k) {
+      const uint8x16_t row = vld1q_u8(src + k * stride + i);
+      const int16x8_t lo = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(row)));
+      const int16x8_t hi = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(row)));
+      a0 = vmlal_n_s16(a0, vget_low_s16(lo), w[k]);
+      a1 = vmlal_n_s16(a1, vget_high_s16(lo), w[k]);
+      a2 = vmlal_n_s16(a2, vget_low_s16(hi), w[k]);
+      a3 = vmlal_n_s16(a3, vget_high_s16(hi), w[k]);
+    }
+    const int16x8_t s0 =
+        vcombine_s16(vqrshrn_n_s32(a0, kBits), vqrshrn_n_s32(a1, kBits));
+    const int16x8_t s1 =
+        vcombine_s16(vqrshrn_n_s32(a2, kBits), vqrshrn_n_s32(a3, kBits));
+    vst1q_u8(dst + i, vcombine_u8(vqmovun_s16(s0), vqmovun_s16(s1)));
+  }
+  vertical_scalar(src, stride, w, count, dst, i, bytes);
+}
+
+#endif // GALLERY_RESAMPLE_NEON
+
+// --- Passes ---------------------------------------------------------------
+
+void horizontal_pass(const Raster &in, Raster &out, ResampleFilter filter,
+                     ResampleIsa isa) {
+  const auto c = coefficients(in.width, out.width, filter);
+  for (std::size_t y = 0; y < in.height; ++y) {
+    const auto *src = in.rgba.data() + y * in.width * 4;
+    auto *dst = out.rgba.data() + y * out.width * 4;
+    switch (isa) {
+#ifdef GALLERY_RESAMPLE_AVX2
+    case ResampleIsa::Avx2:
+      horizontal_avx2(src, dst, c);
+      break;
+#endif
+#ifdef GALLERY_RESAMPLE_NEON
+    case ResampleIsa::Neon:
+      horizontal_neon(src, dst, c);
+      break;
+#endif
+    default:
+      horizontal_scalar(src, dst, c);
+    }
+  }
+}
+
+void vertical_pass(const Raster &in, Raster &out, ResampleFilter filter,
+                   ResampleIsa isa) {
+  const auto c = coefficients(in.height, out.height, filter);
+  const std::size_t stride = in.width * 4;
+  for (std::size_t y = 0; y < out.height; ++y) {
+    const auto *src = in.rgba.data() + std::size_t{c.start[y]} * stride;
+    auto *dst = out.rgba.data() + y * stride;
+    switch (isa) {
+#ifdef GALLERY_RESAMPLE_AVX2
+    case ResampleIsa::Avx2:
+      vertical_avx2(src, stride, c.weights_of(y), c.count[y], dst, stride);
+      break;
+#endif
+#ifdef GALLERY_RESAMPLE_NEON
+    case ResampleIsa::Neon:
+      vertical_neon(src, stride, c.weights_of(y), c.count[y], dst, stride);
+      break;
+#endif
+    default:
+      vertical_scalar(src, stride, c.weights_of(y), c.count[y], dst, 0,
+                      stride);
+    }
+  }
+}
+
+bool has_transparency(const Raster &image) {
+  for (std::size_t i = 3; i < image.rgba.size(); i += 4)
+    if (image.rgba[i] != 255)
+      return true;
+  return false;
+}
+
+void premultiply(Raster &image) {
+  auto *p = image.rgba.data();
+  for (std::size_t i = 0; i < image.rgba.size(); i += 4) {
+    const unsigned a = p[i + 3];
+    for (std::size_t ch = 0; ch < 3; ++ch)
+      p[i + ch] = static_cast<std::uint8_t>((p[i + ch] * a + 127) / 255);
+  }
+}
+
+void unpremultiply(Raster &image) {
+  auto *p = image.rgba.data();
+  for (std::size_t i = 0; i < image.rgba.size(); i += 4) {
+    const unsigned a = p[i + 3];
+    for (std::size_t ch = 0; ch < 3; ++ch)
+      p[i + ch] = a == 0 ? 0
+                         : static_cast<std::uint8_t>(std::min(
+                               255u, (p[i + ch] * 255u + a / 2) / a));
+  }
+}
+
+} // namespace
+
+std::optional<ResampleFilter> parse_resample_filter(std::string_view name) {
+  if (name == "lanczos")
+    return ResampleFilter::Lanczos3;
+  if (name == "mitchell")
+    return ResampleFilter::Mitchell;
+  return std::nullopt;
+}
+
+std::string_view resample_isa_name(ResampleIsa isa) {
+  switch (isa) {
+  case ResampleIsa::Avx2:
+    return "avx2";
+  case ResampleIsa::Neon:
+    return "neon";
+  case ResampleIsa::Scalar:
+    break;
+  }
+  return "scalar";
+}
+
+bool resample_isa_available(ResampleIsa isa) {
+  switch (isa) {
+  case ResampleIsa::Scalar:
+    return true;
+  case ResampleIsa::Avx2:
+#ifdef GALLERY_RESAMPLE_AVX2
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+  case ResampleIsa::Neon:
+#ifdef GALLERY_RESAMPLE_NEON
+    return true;
+#else
+    return false;
+#endif
+  }
+  return false;
+}
+
+ResampleIsa best_resample_isa() {
+  static const ResampleIsa best = [] {
+    for (auto isa : {ResampleIsa::Avx2, ResampleIsa::Neon})
+      if (resample_isa_available(isa))
+        return isa;
+    return ResampleIsa::Scalar;
+  }();
+  return best;
+}
+
+std::pair<std::size_t, std::size_t> fit_to_box(std::size_t width,
+                                               std::size_t height, int size) {
+  if (width == 0 || height == 0 || size <= 0)
+    return {0, 0};
+  const double scale =
+      static_cast<double>(size) / static_cast<double>(std::max(width, height));
+  auto scaled = [scale](std::size_t n) {
+    return std::max<std::size_t>(
+        1, static_cast<std::size_t>(
+               std::floor(static_cast<double>(n) * scale + 0.5)));
+  };
+  return {scaled(width), scaled(height)};
+}
+
+Raster resample(const Raster &source, std::size_t width, std::size_t height,
+                ResampleFilter filter, ResampleIsa isa) {
+  if (source.width == 0 || source.height == 0 || width == 0 || height == 0)
+    throw std::invalid_argument("Cannot resample an empty image");
+  if (!resample_isa_available(isa))
+    isa = ResampleIsa::Scalar;
+
+  const bool alpha = has_transparency(source);
+  Raster premultiplied;
+  if (alpha) {
+    premultiplied = source;
+    premultiply(premultiplied);
+  }
+  const Raster &in = alpha ? premultiplied : source;
+
+  // Rows first: the intermediate is width x source.height.
+  Raster rows;
+  const Raster *current = &in;
+  if (width != in.width) {
+    rows.width = width;
+    rows.height = in.height;
+    rows.rgba.resize(rows.width * rows.height * 4);
+    horizontal_pass(in, rows, filter, isa);
+    current = &rows;
+  }
+
+  Raster out;
+  if (height != current->height) {
+    out.width = current->width;
+    out.height = height;
+    out.rgba.resize(out.width * out.height * 4);
+    vertical_pass(*current, out, filter, isa);
+  } else {
+    out = current == &rows ? std::move(rows) : *current;
+  }
+  if (alpha)
+    unpremultiply(out);
+  return out;
+}
+
+Raster resize_to_box(const Raster &source, int size) {
+  const auto [width, height] = fit_to_box(source.width, source.height, size);
+  if (width == source.width && height == source.height)
+    return source;
+  const bool enlarge = width * height > source.width * source.height;
+  return resample(source, width, height,
+                  enlarge ? ResampleFilter::Mitchell
+                          : ResampleFilter::Lanczos3);
+}
+
+} // namespace importer
@@ -0,0 +1,107 @@
+/**
+ * SPDX-FileComment: Separable image resampler
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file resampler.hpp
+ * @brief Lanczos/Mitchell resampling of 8-bit RGBA with SIMD inner loops
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace importer {
+
+/**
+ * @struct Raster
+ * @brief Packed 8-bit RGBA pixels, rows without padding.
+ */
+struct Raster {
+  std::size_t width = 0;
+  std::size_t height = 0;
+  std::vector<std::uint8_t> rgba;
+};
+
+/**
+ * @enum ResampleFilter
+ * @brief Reconstruction filter, scaled by the reduction factor.
+ */
+enum class ResampleFilter {
+  Lanczos3, ///< Sharp; ImageMagick's default for reductions.
+  Mitchell  ///< B = C = 1/3; ImageMagick's default for enlargements.
+};
+
+/**
+ * @enum ResampleIsa
+ * @brief Instruction set of the inner loops.
+ */
+enum class ResampleIsa {
+  Scalar, ///< Portable C++; always available.
+  Avx2,   ///< x86-64 with AVX2, chosen at run time.
+  Neon    ///< AArch64, where NEON is part of the base ISA.
+};
+
+/**
+ * @brief Parses "lanczos" / "mitchell".
+ */
+std::optional<ResampleFilter> parse_resample_filter(std::string_view name);
+
+/**
+ * @brief Name of an instruction set for reports ("scalar", "avx2", "neon").
+ */
+std::string_view resample_isa_name(ResampleIsa isa);
+
+/**
+ * @brief Whether this binary has the inner loops for @p isa and the CPU
+ * runs them.
+ */
+bool resample_isa_available(ResampleIsa isa);
+
+/**
+ * @brief The fastest available instruction set; checked once.
+ */
+ResampleIsa best_resample_isa();
+
+/**
+ * @brief Dimensions of @p width x @p height fitted into a size x size box,
+ * keeping the aspect ratio and rounding like ImageMagick's Geometry.
+ * Smaller images are enlarged.
+ */
+std::pair<std::size_t, std::size_t> fit_to_box(std::size_t width,
+                                               std::size_t height, int size);
+
+/**
+ * @brief Resamples @p source to @p width x @p height.
+ *
+ * Rows are filtered first, then columns, with 14-bit fixed-point weights
+ * and an 8-bit intermediate. Every instruction set produces the same
+ * bytes. Images with transparency are filtered with premultiplied alpha
+ * so transparent pixels do not bleed their colour. Throws
+ * std::invalid_argument for empty sizes.
+ */
+Raster resample(const Raster &source, std::size_t width, std::size_t height,
+                ResampleFilter filter, ResampleIsa isa = best_resample_isa());
+
+/**
+ * @brief Fits @p source into a size x size box the way ImageMagick's
+ * resize does: Lanczos when reducing, Mitchell when enlarging, and an
+ * unchanged copy when the size already matches.
+ */
+Raster resize_to_box(const Raster &source, int size);
+
+} // namespace importer
@@ -0,0 +1,125 @@
+/**
+ * SPDX-FileComment: Thumbnail pack file store implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file thumb_pack.cpp
+ * @brief Appends thumbnails to per-directory pack files
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "thumb_pack.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <format>
+#include <memory>
+#include <stdexcept>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace importer {
+
+std::optional<ThumbStore> parse_thumb_store(std::string_view name) {
+  if (name == "files")
+    return ThumbStore::Files;
+  if (name == "packs")
+    return ThumbStore::Packs;
+  return std::nullopt;
+}
+
+ThumbPackStore::ThumbPackStore(
+    domain::interfaces::IThumbnailPackRepository &repo, fs::path root)
+    : repo_(repo), root_(std::move(root)) {}
+
+fs::path ThumbPackStore::pack_path(const std::string &thumb_path, int size) {
+  return fs::path("packs") / std::to_string(size) /
+         fs::path(thumb_path).parent_path() / "thumbs.pack";
+}
+
+domain::models::PackedThumbnail
+ThumbPackStore::append(const std::string &thumb_path, int size,
+                       std::span<const std::uint8_t> data) {
+  const auto relative = pack_path(thumb_path, size);
+  const auto path = root_ / relative;
+  auto fail = [&](const char *what) {
+    return std::runtime_error(
+        std::format("{} {}: {}", what, path.string(), std::strerror(errno)));
+  };
+
+  int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC,
+                  0644);
+  if (fd < 0 && errno == ENOENT) {
+    fs::create_directories(path.parent_path());
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+  }
+  if (fd < 0)
+    throw fail("open");
+  // Closing the descriptor also drops the lock.
+  std::unique_ptr<int, void (*)(int *)> guard(&fd, [](int *f) { ::close(*f); });
+
+  // Each open() has its own file description, so the lock also orders
+  // threads of this process.
+  while (::flock(fd, LOCK_EX) != 0) {
+    if (errno != EINTR)
+      throw fail("lock");
+  }
+  struct stat st {};
+  if (::fstat(fd, &st) != 0)
+    throw fail("stat");
+
+  domain::models::PackedThumbnail packed;
+  packed.thumb_path = thumb_path;
+  packed.size = size;
+  packed.pack = relative.string();
+  packed.offset = static_cast<std::int64_t>(st.st_size);
+  packed.length = static_cast<std::int64_t>(data.size());
+
+  std::size_t written = 0;
+  while (written < data.size()) {
+    ssize_t n = ::write(fd, data.data() + written, data.size() - written);
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      auto error = fail("write");
+      // Drop the partial record. If that fails as well, nothing refers to
+      // the tail; it only wastes space.
+      [[maybe_unused]] int rc = ::ftruncate(fd, st.st_size);
+      throw error;
+    }
+    written += static_cast<std::size_t>(n);
+  }
+  return packed;
+}
+
+std::expected<void, std::string> ThumbPackStore::record(
+    const std::vector<domain::models::PackedThumbnail> &thumbnails) {
+  return repo_.record(thumbnails);
+}
+
+std::expected<std::vector<std::string>, std::string>
+ThumbPackStore::list(int size) {
+  auto paths = repo_.list(size);
+  if (paths)
+    std::ranges::sort(*paths);
+  return paths;
+}
+
+std::expected<void, std::string>
+ThumbPackStore::remove(int size, const std::vector<std::string> &thumb_paths) {
+  return repo_.remove(size, thumb_paths);
+}
+
+} // namespace importer
@@ -0,0 +1,103 @@
+/**
+ * SPDX-FileComment: Thumbnail pack file store
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file thumb_pack.hpp
+ * @brief Appends thumbnails to per-directory pack files
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include "domain/interfaces/i_thumbnail_pack_repository.hpp"
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace importer {
+
+/**
+ * @enum ThumbStore
+ * @brief Where rendered thumbnails are written.
+ */
+enum class ThumbStore {
+  Files, ///< One WebP file per photo and size.
+  Packs  ///< Appended to one pack file per directory and size.
+};
+
+/**
+ * @brief Parses "files" / "packs".
+ */
+std::optional<ThumbStore> parse_thumb_store(std::string_view name);
+
+/**
+ * @class ThumbPackStore
+ * @brief Writes thumbnails into pack files and records where they went.
+ *
+ * All thumbnails of one size whose originals share a directory go into
+ * packs/<size>/<directory>/thumbs.pack below the thumbnail root, one after
+ * the other, so a grid page of a location is a single sequential read.
+ * append() may be called from any thread and by several importer processes
+ * at once: every append holds an exclusive flock on the pack.
+ */
+class ThumbPackStore {
+public:
+  ThumbPackStore(domain::interfaces::IThumbnailPackRepository &repo,
+                 std::filesystem::path root);
+
+  /**
+   * @brief Appends one encoded thumbnail to its pack.
+   * @param thumb_path Thumbnail path relative to the size directory, as
+   * stored in photos.thumb_path.
+   * @return Location to record once the photo is persisted.
+   * @throws std::runtime_error if the pack cannot be written.
+   */
+  domain::models::PackedThumbnail append(const std::string &thumb_path,
+                                         int size,
+                                         std::span<const std::uint8_t> data);
+
+  /**
+   * @brief Stores locations returned by append().
+   */
+  std::expected<void, std::string>
+  record(const std::vector<domain::models::PackedThumbnail> &thumbnails);
+
+  /**
+   * @brief thumb_path of every packed thumbnail of one size, sorted
+   * bytewise.
+   */
+  std::expected<std::vector<std::string>, std::string> list(int size);
+
+  /**
+   * @brief Forgets packed thumbnails of one size. Their bytes stay in the
+   * pack until it is rebuilt.
+   */
+  std::expected<void, std::string>
+  remove(int size, const std::vector<std::string> &thumb_paths);
+
+  /**
+   * @brief Pack holding a thumbnail, relative to the thumbnail root.
+   */
+  static std::filesystem::path pack_path(const std::string &thumb_path,
+                                         int size);
+
+private:
+  domain::interfaces::IThumbnailPackRepository &repo_;
+  std::filesystem::path root_;
+};
+
+} // namespace importer
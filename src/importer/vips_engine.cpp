@@ -0,0 +1,228 @@
+/**
+ * SPDX-FileComment: libvips image engine
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file vips_engine.cpp
+ * @brief Image engine backed by libvips (built with GALLERY_HAVE_VIPS)
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#ifdef GALLERY_HAVE_VIPS
+
+#include "vips_engine.hpp"
+#include <algorithm>
+#include <cctype>
+#include <format>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <vips/vips.h>
+
+namespace importer {
+
+namespace {
+
+using VipsPtr = std::unique_ptr<VipsImage, void (*)(gpointer)>;
+
+VipsPtr adopt(VipsImage *image) { return VipsPtr(image, &g_object_unref); }
+
+std::runtime_error vips_failure(std::string_view what) {
+  std::string message = std::format("{}: {}", what, vips_error_buffer());
+  vips_error_clear();
+  return std::runtime_error(message);
+}
+
+class VipsDecoded : public DecodedImage {
+public:
+  /// Pixels in memory: the largest thumbnail when base_is_largest is set,
+  /// otherwise the whole original (which then fits the largest box).
+  VipsPtr base = adopt(nullptr);
+  bool base_is_largest = false;
+  /// Independent mode renders every size while the bytes are available.
+  std::vector<Thumbnail> rendered;
+};
+
+// Magick's Geometry resize enlarges originals smaller than the box and does
+// not apply the EXIF orientation; do the same for comparable output.
+VipsPtr thumbnail_of(VipsImage *image, int size) {
+  VipsImage *out = nullptr;
+  if (vips_thumbnail_image(image, &out, size, "height", size, "size",
+                           VIPS_SIZE_BOTH, "no_rotate", TRUE, nullptr))
+    throw vips_failure("thumbnail");
+  return adopt(out);
+}
+
+VipsPtr thumbnail_of(std::span<const std::uint8_t> data, int size) {
+  VipsImage *out = nullptr;
+  // The buffer is only read; the C API is not const-correct.
+  if (vips_thumbnail_buffer(const_cast<std::uint8_t *>(data.data()),
+                            data.size(), &out, size, "height", size, "size",
+                            VIPS_SIZE_BOTH, "no_rotate", TRUE, nullptr))
+    throw vips_failure("thumbnail");
+  return adopt(out);
+}
+
+VipsPtr load(std::span<const std::uint8_t> data) {
+  VipsImage *image = vips_image_new_from_buffer(data.data(), data.size(), "",
+                                                nullptr);
+  if (!image)
+    throw vips_failure("load");
+  return adopt(image);
+}
+
+/// Runs the pipeline behind @p image into memory, so later operations
+/// neither recompute it nor need its source buffer.
+VipsPtr materialize(VipsImage *image) {
+  VipsImage *copy = vips_image_copy_memory(image);
+  if (!copy)
+    throw vips_failure("copy");
+  return adopt(copy);
+}
+
+Raster to_raster(VipsImage *image) {
+  VipsImage *out = nullptr;
+  if (vips_colourspace(image, &out, VIPS_INTERPRETATION_sRGB, nullptr))
+    throw vips_failure("colourspace");
+  auto pixels = adopt(out);
+  if (vips_image_get_bands(pixels.get()) == 3) {
+    if (vips_bandjoin_const1(pixels.get(), &out, 255.0, nullptr))
+      throw vips_failure("alpha");
+    pixels = adopt(out);
+  }
+  if (vips_image_get_format(pixels.get()) != VIPS_FORMAT_UCHAR) {
+    if (vips_cast_uchar(pixels.get(), &out, nullptr))
+      throw vips_failure("cast");
+    pixels = adopt(out);
+  }
+
+  std::size_t size = 0;
+  auto *memory = static_cast<std::uint8_t *>(
+      vips_image_write_to_memory(pixels.get(), &size));
+  if (!memory)
+    throw vips_failure("write");
+  Raster raster;
+  raster.width = static_cast<std::size_t>(vips_image_get_width(pixels.get()));
+  raster.height = static_cast<std::size_t>(vips_image_get_height(pixels.get()));
+  raster.rgba.assign(memory, memory + size);
+  g_free(memory);
+  return raster;
+}
+
+} // namespace
+
+VipsEngine::VipsEngine() {
+  static std::once_flag initialised;
+  std::call_once(initialised, [] {
+    if (VIPS_INIT("gallery-import"))
+      throw vips_failure("vips_init");
+    // One photo per core already keeps every core busy.
+    vips_concurrency_set(1);
+    // The operation cache would keep originals and thumbnails of finished
+    // photos alive.
+    vips_cache_set_max(0);
+  });
+}
+
+ImageInfo VipsEngine::probe(std::span<const std::uint8_t> data) const {
+  // Opening only parses the header; pixels are decoded on demand.
+  auto image = load(data);
+  ImageInfo info;
+  info.width = vips_image_get_width(image.get());
+  info.height = vips_image_get_height(image.get());
+  // "VipsForeignLoadJpegBuffer" -> "JPEG"
+  const char *name = vips_foreign_find_load_buffer(data.data(), data.size());
+  std::string_view loader = name ? name : "";
+  if (loader.starts_with("VipsForeignLoad"))
+    loader.remove_prefix(15);
+  if (auto end = loader.find("Buffer"); end != std::string_view::npos)
+    loader = loader.substr(0, end);
+  for (char c : loader)
+    info.format.push_back(static_cast<char>(
+        std::toupper(static_cast<unsigned char>(c))));
+  return info;
+}
+
+std::unique_ptr<DecodedImage>
+VipsEngine::decode(std::span<const std::uint8_t> data, const ImageInfo &info,
+                   const DerivativeGenerator &ladder,
+                   const DecodeOptions &options) const {
+  auto decoded = std::make_unique<VipsDecoded>();
+  const auto &sizes = ladder.sizes();
+
+  if (ladder.mode() == ResizeMode::Independent) {
+    for (int size : sizes)
+      decoded->rendered.push_back(
+          {size, to_raster(thumbnail_of(data, size).get())});
+    return decoded;
+  }
+
+  // Like DerivativeGenerator: an original that fits the largest box is
+  // kept as is and every size is resampled from it.
+  if (std::max(info.width, info.height) <= sizes.front()) {
+    decoded->base = materialize(load(data).get());
+  } else if (options.shrink_on_load) {
+    decoded->base = materialize(thumbnail_of(data, sizes.front()).get());
+    decoded->base_is_largest = true;
+  } else {
+    decoded->base =
+        materialize(thumbnail_of(load(data).get(), sizes.front()).get());
+    decoded->base_is_largest = true;
+  }
+  return decoded;
+}
+
+std::vector<Thumbnail>
+VipsEngine::render(DecodedImage &image,
+                   const DerivativeGenerator &ladder) const {
+  auto &decoded = static_cast<VipsDecoded &>(image);
+  if (!decoded.rendered.empty())
+    return std::move(decoded.rendered);
+
+  Raster base = to_raster(decoded.base.get());
+  decoded.base.reset();
+  if (!decoded.base_is_largest)
+    return ladder.generate(base);
+
+  // libvips already rendered the largest size; cascade the rest from it
+  // with the SIMD resampler.
+  const auto &sizes = ladder.sizes();
+  std::vector<Thumbnail> out;
+  out.reserve(sizes.size());
+  out.push_back({sizes.front(), std::move(base)});
+  for (std::size_t i = 1; i < sizes.size(); ++i)
+    out.push_back({sizes[i], resize_to_box(out.back().pixels, sizes[i])});
+  return out;
+}
+
+std::size_t VipsEngine::estimate_memory(const std::optional<HeaderInfo> &header,
+                                        std::size_t file_size,
+                                        const DerivativeGenerator &ladder,
+                                        bool shrink_on_load) const {
+  // 8-bit RGB(A); the resampler itself only holds a few strips.
+  constexpr std::size_t kBytesPerPixel = 4;
+  std::size_t bytes = file_size;
+  if (!shrink_on_load && header && header->width > 0 && header->height > 0)
+    bytes += static_cast<std::size_t>(header->width) *
+             static_cast<std::size_t>(header->height) * kBytesPerPixel;
+  // The largest size in libvips plus every size as RGBA for the encoder.
+  const auto largest = static_cast<std::size_t>(ladder.sizes().front());
+  bytes += largest * largest * kBytesPerPixel;
+  for (int size : ladder.sizes()) {
+    const auto edge = static_cast<std::size_t>(size);
+    bytes += edge * edge * kBytesPerPixel;
+  }
+  return bytes;
+}
+
+} // namespace importer
+
+#endif // GALLERY_HAVE_VIPS
@@ -0,0 +1,55 @@
+/**
+ * SPDX-FileComment: libvips image engine
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file vips_engine.hpp
+ * @brief Image engine backed by libvips (built with GALLERY_HAVE_VIPS)
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include "image_engine.hpp"
+
+namespace importer {
+
+/**
+ * @class VipsEngine
+ * @brief Renders thumbnails with libvips' demand-driven pipeline.
+ *
+ * decode() runs vips_thumbnail on the encoded bytes: JPEG and WebP are
+ * shrunk on load, other formats are streamed through the resampler in
+ * strips, so the full-resolution original is never held in memory. Only
+ * the largest size is kept until render(), which cascades the smaller
+ * sizes from it with resize_to_box(). Embedded previews are not used;
+ * shrink-on-load already makes the decode cheap.
+ */
+class VipsEngine : public IImageEngine {
+public:
+  /// Initialises libvips on first use; throws if that fails.
+  VipsEngine();
+
+  ImageEngineKind kind() const override { return ImageEngineKind::Vips; }
+  ImageInfo probe(std::span<const std::uint8_t> data) const override;
+  std::unique_ptr<DecodedImage>
+  decode(std::span<const std::uint8_t> data, const ImageInfo &info,
+         const DerivativeGenerator &ladder,
+         const DecodeOptions &options) const override;
+  std::vector<Thumbnail>
+  render(DecodedImage &image, const DerivativeGenerator &ladder) const override;
+  std::size_t estimate_memory(const std::optional<HeaderInfo> &header,
+                              std::size_t file_size,
+                              const DerivativeGenerator &ladder,
+                              bool shrink_on_load) const override;
+};
+
+} // namespace importer
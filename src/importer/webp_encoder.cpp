@@ -0,0 +1,159 @@
+/**
+ * SPDX-FileComment: WebP thumbnail encoder backends implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file webp_encoder.cpp
+ * @brief Encodes derivatives via libwebp directly or via ImageMagick
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "webp_encoder.hpp"
+#include <Magick++.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <webp/encode.h>
+
+namespace fs = std::filesystem;
+
+namespace importer {
+
+std::optional<EncoderBackend> parse_encoder_backend(std::string_view name) {
+  if (name == "libwebp")
+    return EncoderBackend::LibWebP;
+  if (name == "magick")
+    return EncoderBackend::Magick;
+  return std::nullopt;
+}
+
+WebpEncoder::WebpEncoder(EncoderBackend backend, WebpSettings settings)
+    : backend_(backend), settings_(settings) {}
+
+std::vector<std::uint8_t> WebpEncoder::encode(const Raster &image) const {
+  if (backend_ == EncoderBackend::Magick)
+    return encode_magick(image);
+  return encode_rgba(image.rgba.data(), static_cast<int>(image.width),
+                     static_cast<int>(image.height),
+                     static_cast<int>(image.width * 4));
+}
+
+std::vector<std::uint8_t> WebpEncoder::encode_rgba(const std::uint8_t *rgba,
+                                                   int width, int height,
+                                                   int stride) const {
+  WebPConfig config;
+  if (!WebPConfigInit(&config))
+    throw std::runtime_error("libwebp version mismatch");
+  config.quality = settings_.quality;
+  config.method = settings_.method;
+  config.thread_level = settings_.multithreaded ? 1 : 0;
+  if (!WebPValidateConfig(&config))
+    throw std::runtime_error("Invalid WebP encoder settings");
+
+  WebPPicture picture;
+  if (!WebPPictureInit(&picture))
+    throw std::runtime_error("libwebp version mismatch");
+  picture.use_argb = 1;
+  picture.width = width;
+  picture.height = height;
+
+  WebPMemoryWriter writer;
+  WebPMemoryWriterInit(&writer);
+  picture.writer = WebPMemoryWrite;
+  picture.custom_ptr = &writer;
+
+  // Fully opaque alpha is detected by the encoder and not stored.
+  bool ok = WebPPictureImportRGBA(&picture, rgba, stride) &&
+            WebPEncode(&config, &picture);
+  auto error = picture.error_code;
+  WebPPictureFree(&picture);
+
+  if (!ok) {
+    WebPMemoryWriterClear(&writer);
+    throw std::runtime_error(
+        std::format("WebPEncode failed (error {})", static_cast<int>(error)));
+  }
+
+  std::vector<std::uint8_t> out(writer.mem, writer.mem + writer.size);
+  WebPMemoryWriterClear(&writer);
+  return out;
+}
+
+std::vector<std::uint8_t>
+WebpEncoder::encode_magick(const Raster &image) const {
+  Magick::Image thumb;
+  thumb.read(image.width, image.height, "RGBA", Magick::CharPixel,
+             image.rgba.data());
+  thumb.magick("WEBP");
+  thumb.quality(static_cast<std::size_t>(settings_.quality));
+  thumb.defineValue("webp", "method", std::to_string(settings_.method));
+  if (settings_.multithreaded)
+    thumb.defineValue("webp", "thread-level", "1");
+
+  Magick::Blob blob;
+  thumb.write(&blob);
+  const auto *data = static_cast<const std::uint8_t *>(blob.data());
+  return std::vector<std::uint8_t>(data, data + blob.length());
+}
+
+void write_file_atomic(const fs::path &path,
+                       std::span<const std::uint8_t> data) {
+  // mkstemp() picks a name no other thread, process or host (workers
+  // sharing an NFS thumbnail root) is using and creates it with O_EXCL.
+  std::string tmp = path.string() + ".XXXXXX";
+  int fd = ::mkstemp(tmp.data());
+  if (fd < 0) {
+    throw std::runtime_error(
+        std::format("create {}: {}", tmp, std::strerror(errno)));
+  }
+
+  // First failing step and its errno; later cleanup must not clobber it.
+  const char *step = nullptr;
+  int error = 0;
+  auto failed = [&](const char *what) {
+    step = what;
+    error = errno;
+  };
+  // mkstemp() creates the file 0600; the backend must be able to read it.
+  if (::fchmod(fd, 0644) != 0)
+    failed("chmod");
+  std::size_t written = 0;
+  while (!step && written < data.size()) {
+    ssize_t n = ::write(fd, data.data() + written, data.size() - written);
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      failed("write");
+      break;
+    }
+    written += static_cast<std::size_t>(n);
+  }
+  // Without it, a crash after the rename can leave an empty thumbnail in
+  // place of the old one.
+  if (!step && ::fdatasync(fd) != 0)
+    failed("sync");
+  if (::close(fd) != 0 && !step)
+    failed("close");
+  if (!step && ::rename(tmp.c_str(), path.c_str()) != 0)
+    failed("rename");
+  if (step) {
+    ::unlink(tmp.c_str());
+    throw std::runtime_error(
+        std::format("{} {}: {}", step, tmp, std::strerror(error)));
+  }
+}
+
+} // namespace importer
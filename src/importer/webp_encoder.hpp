@@ -0,0 +1,93 @@
+/**
+ * SPDX-FileComment: WebP thumbnail encoder backends
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file webp_encoder.hpp
+ * @brief Encodes derivatives via libwebp directly or via ImageMagick
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include "image_engine.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace importer {
+
+/**
+ * @enum EncoderBackend
+ * @brief Library used to produce the WebP bytes.
+ */
+enum class EncoderBackend {
+  LibWebP, ///< RGBA buffer straight into WebPEncode().
+  Magick   ///< The RGBA pixels through Magick's WEBP coder.
+};
+
+/**
+ * @brief Parses "libwebp" / "magick".
+ */
+std::optional<EncoderBackend> parse_encoder_backend(std::string_view name);
+
+/**
+ * @struct WebpSettings
+ * @brief Size/speed trade-off of the WebP encoder.
+ */
+struct WebpSettings {
+  float quality = 75.0f; ///< 0..100, libwebp/ImageMagick default is 75.
+  int method = 4;        ///< 0 (fast) .. 6 (small), libwebp default is 4.
+  bool multithreaded = false; ///< libwebp thread_level; off since the
+                              ///< pipeline already uses every core.
+};
+
+/**
+ * @class WebpEncoder
+ * @brief Turns a derivative into WebP bytes with the selected backend.
+ */
+class WebpEncoder {
+public:
+  WebpEncoder(EncoderBackend backend, WebpSettings settings);
+
+  /**
+   * @brief Encodes a thumbnail; throws std::runtime_error on failure.
+   */
+  std::vector<std::uint8_t> encode(const Raster &image) const;
+
+  /**
+   * @brief Encodes an 8-bit RGBA buffer with libwebp.
+   */
+  std::vector<std::uint8_t> encode_rgba(const std::uint8_t *rgba, int width,
+                                        int height, int stride) const;
+
+  EncoderBackend backend() const { return backend_; }
+
+private:
+  std::vector<std::uint8_t> encode_magick(const Raster &image) const;
+
+  EncoderBackend backend_;
+  WebpSettings settings_;
+};
+
+/**
+ * @brief Writes a file via a uniquely named temporary sibling, fsync and
+ * rename(), so readers never see a partially written thumbnail, not even
+ * after a crash. The temporary file is removed if a step fails.
+ * @throws std::runtime_error naming the failed step.
+ */
+void write_file_atomic(const std::filesystem::path &path,
+                       std::span<const std::uint8_t> data);
+
+} // namespace importer
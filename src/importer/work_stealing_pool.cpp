@@ -0,0 +1,142 @@
+/**
+ * SPDX-FileComment: Work-stealing thread pool implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file work_stealing_pool.cpp
+ * @brief Implementation of the work-stealing thread pool
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "work_stealing_pool.hpp"
+#include <print>
+
+namespace importer {
+
+namespace {
+// Identifies the pool (and slot) the current thread works for, so tasks
+// submitted from inside a worker land on that worker's own deque.
+thread_local const WorkStealingPool *tl_pool = nullptr;
+thread_local std::size_t tl_index = 0;
+} // namespace
+
+std::size_t WorkStealingPool::default_size() {
+  auto n = std::thread::hardware_concurrency();
+  return n == 0 ? 1 : n;
+}
+
+WorkStealingPool::WorkStealingPool(
+    std::size_t threads, std::function<void(std::size_t)> on_thread_start)
+    : on_thread_start_(std::move(on_thread_start)) {
+  if (threads == 0)
+    threads = default_size();
+
+  workers_.reserve(threads);
+  for (std::size_t i = 0; i < threads; ++i)
+    workers_.push_back(std::make_unique<Worker>());
+
+  threads_.reserve(threads);
+  for (std::size_t i = 0; i < threads; ++i)
+    threads_.emplace_back([this, i] { run(i); });
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  {
+    std::lock_guard lock(sleep_mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (auto &t : threads_) {
+    if (t.joinable())
+      t.join();
+  }
+}
+
+void WorkStealingPool::submit(Task task) {
+  std::size_t target = (tl_pool == this)
+                           ? tl_index
+                           : next_worker_.fetch_add(1) % workers_.size();
+
+  in_flight_.fetch_add(1);
+  queued_.fetch_add(1);
+  {
+    auto &worker = *workers_[target];
+    std::lock_guard lock(worker.mutex);
+    worker.tasks.push_back(std::move(task));
+  }
+  // Taking the sleep mutex orders the counter update before a sleeping
+  // worker re-checks its predicate, so the wakeup cannot be lost.
+  { std::lock_guard lock(sleep_mutex_); }
+  wake_.notify_one();
+}
+
+void WorkStealingPool::wait_idle() {
+  std::unique_lock lock(sleep_mutex_);
+  idle_.wait(lock, [this] { return in_flight_.load() == 0; });
+}
+
+bool WorkStealingPool::try_pop_local(std::size_t index, Task &task) {
+  auto &worker = *workers_[index];
+  std::lock_guard lock(worker.mutex);
+  if (worker.tasks.empty())
+    return false;
+  task = std::move(worker.tasks.back());
+  worker.tasks.pop_back();
+  return true;
+}
+
+bool WorkStealingPool::try_steal(std::size_t thief, Task &task) {
+  const std::size_t n = workers_.size();
+  for (std::size_t offset = 1; offset < n; ++offset) {
+    auto &victim = *workers_[(thief + offset) % n];
+    std::lock_guard lock(victim.mutex);
+    if (victim.tasks.empty())
+      continue;
+    task = std::move(victim.tasks.front());
+    victim.tasks.pop_front();
+    return true;
+  }
+  return false;
+}
+
+void WorkStealingPool::run(std::size_t index) {
+  tl_pool = this;
+  tl_index = index;
+  if (on_thread_start_)
+    on_thread_start_(index);
+
+  for (;;) {
+    Task task;
+    if (try_pop_local(index, task) || try_steal(index, task)) {
+      queued_.fetch_sub(1);
+      try {
+        task();
+      } catch (const std::exception &e) {
+        std::println(stderr, "Worker {}: unhandled task error: {}", index,
+                     e.what());
+      } catch (...) {
+        std::println(stderr, "Worker {}: unhandled task error", index);
+      }
+      if (in_flight_.fetch_sub(1) == 1) {
+        std::lock_guard lock(sleep_mutex_);
+        idle_.notify_all();
+      }
+      continue;
+    }
+
+    std::unique_lock lock(sleep_mutex_);
+    wake_.wait(lock, [this] { return stopping_ || queued_.load() > 0; });
+    if (stopping_ && queued_.load() == 0)
+      return;
+  }
+}
+
+} // namespace importer
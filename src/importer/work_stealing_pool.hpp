@@ -0,0 +1,112 @@
+/**
+ * SPDX-FileComment: Work-stealing thread pool
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file work_stealing_pool.hpp
+ * @brief Thread pool with per-worker deques and task stealing
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace importer {
+
+/**
+ * @class WorkStealingPool
+ * @brief Fixed-size pool where every worker owns a task deque.
+ *
+ * Tasks submitted from inside a worker go to that worker's own deque and are
+ * popped LIFO, so a follow-up stage usually runs on the core that still has
+ * the image in cache. Idle workers steal FIFO from the other deques.
+ */
+class WorkStealingPool {
+public:
+  using Task = std::function<void()>;
+
+  /**
+   * @brief Starts the worker threads.
+   * @param threads Number of workers; 0 selects default_size().
+   * @param on_thread_start Optional hook run once on every worker thread
+   * before it takes its first task (receives the worker index).
+   */
+  explicit WorkStealingPool(
+      std::size_t threads,
+      std::function<void(std::size_t)> on_thread_start = {});
+
+  /**
+   * @brief Finishes all queued tasks, then joins the workers.
+   */
+  ~WorkStealingPool();
+
+  WorkStealingPool(const WorkStealingPool &) = delete;
+  WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+  /**
+   * @brief Queues a task for execution.
+   */
+  void submit(Task task);
+
+  /**
+   * @brief Blocks until every submitted task has finished.
+   */
+  void wait_idle();
+
+  /**
+   * @brief Number of worker threads.
+   */
+  std::size_t size() const { return workers_.size(); }
+
+  /**
+   * @brief Number of queued tasks that have not started yet.
+   */
+  std::size_t queued() const { return queued_.load(); }
+
+  /**
+   * @brief Worker count matching the machine (hardware concurrency).
+   */
+  static std::size_t default_size();
+
+private:
+  struct Worker {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  void run(std::size_t index);
+  bool try_pop_local(std::size_t index, Task &task);
+  bool try_steal(std::size_t thief, Task &task);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+  std::function<void(std::size_t)> on_thread_start_;
+
+  std::atomic<std::size_t> queued_{0};
+  std::atomic<std::size_t> in_flight_{0};
+  std::atomic<std::size_t> next_worker_{0};
+
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  std::condition_variable idle_;
+  bool stopping_ = false;
+};
+
+} // namespace importer
@@ -89,10 +89,19 @@ CREATE TABLE IF NOT EXISTS photos (
     gps_lat DOUBLE PRECISION,
     gps_lon DOUBLE PRECISION,
     gps_alt DOUBLE PRECISION,
+    content_hash TEXT,
+    blurhash TEXT,
+    dominant_color TEXT,
     is_public BOOLEAN DEFAULT TRUE,
     created_at TIMESTAMPTZ DEFAULT CURRENT_TIMESTAMP
 );
 
+-- Columns added after the first release; CREATE TABLE IF NOT EXISTS leaves
+-- existing tables alone.
+ALTER TABLE photos ADD COLUMN IF NOT EXISTS content_hash TEXT;
+ALTER TABLE photos ADD COLUMN IF NOT EXISTS blurhash TEXT;
+ALTER TABLE photos ADD COLUMN IF NOT EXISTS dominant_color TEXT;
+
 CREATE TABLE IF NOT EXISTS photo_tags (
     photo_id UUID REFERENCES photos(id) ON DELETE CASCADE,
     tag TEXT NOT NULL,
@@ -120,9 +129,60 @@ CREATE TABLE IF NOT EXISTS photo_metadata_xmp (
     PRIMARY KEY (photo_id, key)
 );
 
+-- ============================================================
+-- IMPORTER
+-- ============================================================
+
+-- File state of every imported original; lets gallery-import --incremental
+-- skip unchanged files before decoding them.
+CREATE TABLE IF NOT EXISTS import_manifest (
+    file_path TEXT PRIMARY KEY,
+    file_size BIGINT NOT NULL,
+    mtime_ns BIGINT NOT NULL,
+    inode BIGINT NOT NULL,
+    content_hash TEXT NOT NULL,
+    photo_id UUID REFERENCES photos(id) ON DELETE CASCADE,
+    updated_at TIMESTAMPTZ DEFAULT CURRENT_TIMESTAMP
+);
+
+-- Work queue for distributed imports: "gallery-import enqueue" fills it,
+-- any number of "gallery-import worker" processes drain it.
+CREATE TABLE IF NOT EXISTS import_jobs (
+    id BIGSERIAL PRIMARY KEY,
+    base_path TEXT NOT NULL,
+    file_path TEXT NOT NULL UNIQUE,
+    status TEXT NOT NULL DEFAULT 'pending'
+        CHECK (status IN ('pending', 'running', 'done', 'failed')),
+    attempts INTEGER NOT NULL DEFAULT 0,
+    max_attempts INTEGER NOT NULL DEFAULT 3,
+    worker TEXT,
+    lease_until TIMESTAMPTZ,
+    last_error TEXT,
+    created_at TIMESTAMPTZ DEFAULT CURRENT_TIMESTAMP,
+    updated_at TIMESTAMPTZ DEFAULT CURRENT_TIMESTAMP
+);
+
+-- Thumbnails written with gallery-import --thumb-store packs: byte range of
+-- each size inside a pack file below the thumbnail root. Keyed like
+-- photos.thumb_path, so duplicates sharing thumbnails share the entries; the
+-- importer deletes them with the last photo using them. Packs are append-only:
+-- bytes of replaced or deleted entries stay in the file until it is rebuilt.
+CREATE TABLE IF NOT EXISTS thumbnail_packs (
+    thumb_path TEXT NOT NULL,
+    size INTEGER NOT NULL,
+    pack TEXT NOT NULL,
+    pack_offset BIGINT NOT NULL,
+    length BIGINT NOT NULL,
+    PRIMARY KEY (thumb_path, size)
+);
+
 -- Indexes for performance
 CREATE INDEX idx_photos_location ON photos(location_id);
 CREATE INDEX idx_photos_taken_at ON photos(taken_at);
+CREATE INDEX IF NOT EXISTS idx_photos_content_hash ON photos(content_hash);
+CREATE INDEX IF NOT EXISTS idx_photos_thumb_path ON photos(thumb_path);
+CREATE INDEX IF NOT EXISTS idx_import_jobs_open ON import_jobs(id)
+    WHERE status IN ('pending', 'running');
 CREATE INDEX idx_locations_hierarchy ON locations(continent, country, province, city);
 
 -- ============================================================
@@ -0,0 +1,183 @@
+/**
+ * SPDX-FileComment: Import Job Queue Repository Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file import_job_repository.cpp
+ * @brief PostgreSQL Implementation of the Import Job Queue Repository
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "import_job_repository.hpp"
+#include "infra/util/pg_array.hpp"
+#include <drogon/drogon.h>
+
+namespace infra::repositories {
+
+using infra::util::to_pg_array;
+
+std::expected<std::size_t, std::string>
+PostgresImportJobRepository::enqueue(
+    const std::string &base_path, const std::vector<std::string> &file_paths) {
+  if (file_paths.empty())
+    return 0;
+  auto db = drogon::app().getDbClient();
+  try {
+    auto result = db->execSqlSync(
+        "INSERT INTO import_jobs (base_path, file_path) "
+        "SELECT $1, unnest($2::text[]) "
+        "ON CONFLICT (file_path) DO UPDATE SET base_path = EXCLUDED.base_path, "
+        "status = 'pending', attempts = 0, worker = NULL, lease_until = NULL, "
+        "last_error = NULL, updated_at = CURRENT_TIMESTAMP "
+        "WHERE import_jobs.status IN ('done', 'failed')",
+        base_path, to_pg_array(file_paths));
+    return static_cast<std::size_t>(result.affectedRows());
+  } catch (const std::exception &e) {
+    return std::unexpected(e.what());
+  }
+}
+
+std::expected<std::vector<ImportJob>, std::string>
+PostgresImportJobRepository::claim(const std::string &worker,
+                                   std::size_t limit,
+                                   std::chrono::seconds lease) {
+  auto db = drogon::app().getDbClient();
+  try {
+    // SKIP LOCKED lets concurrent workers each take a disjoint set of rows
+    // without blocking on one another.
+    auto result = db->execSqlSync(
+        "UPDATE import_jobs j SET status = 'running', "
+        "attempts = j.attempts + 1, worker = $1, "
+        "lease_until = CURRENT_TIMESTAMP + make_interval(secs => $2::int), "
+        "updated_at = CURRENT_TIMESTAMP "
+        "FROM (SELECT id FROM import_jobs "
+        "      WHERE (status = 'pending' OR "
+        "             (status = 'running' AND lease_until < CURRENT_TIMESTAMP)) "
+        "        AND attempts < max_attempts "
+        "      ORDER BY id LIMIT $3::int FOR UPDATE SKIP LOCKED) c "
+        "WHERE j.id = c.id "
+        "RETURNING j.id, j.base_path, j.file_path, j.attempts",
+        worker, std::to_string(lease.count()), std::to_string(limit));
+    std::vector<ImportJob> jobs;
+    jobs.reserve(result.size());
+    for (const auto &row : result) {
+      ImportJob job;
+      job.id = row["id"].template as<int64_t>();
+      job.base_path = row["base_path"].template as<std::string>();
+      job.file_path = row["file_path"].template as<std::string>();
+      job.attempts = row["attempts"].template as<int>();
+      jobs.push_back(std::move(job));
+    }
+    return jobs;
+  } catch (const std::exception &e) {
+    return std::unexpected(e.what());
+  }
+}
+
+std::expected<void, std::string>
+PostgresImportJobRepository::renew(const std::string &worker,
+                                   const std::vector<std::int64_t> &ids,
+                                   std::chrono::seconds lease) {
+  if (ids.empty())
+    return {};
+  auto db = drogon::app().getDbClient();
+  try {
+    db->execSqlSync(
+        "UPDATE import_jobs SET "
+        "lease_until = CURRENT_TIMESTAMP + make_interval(secs => $3::int) "
+        "WHERE id = ANY($1::bigint[]) AND worker = $2 AND status = 'running'",
+        to_pg_array(ids), worker, std::to_string(lease.count()));
+    return {};
+  } catch (const std::exception &e) {
+    return std::unexpected(e.what());
+  }
+}
+
+std::expected<void, std::string>
+PostgresImportJobRepository::complete(const std::string &worker,
+                                      const std::vector<std::int64_t> &ids) {
+  if (ids.empty())
+    return {};
+  auto db = drogon::app().getDbClient();
+  try {
+    // The worker check keeps a slow worker whose lease expired from
+    // overwriting the outcome of the worker that took the job over.
+    db->execSqlSync(
+        "UPDATE import_jobs SET status = 'done', lease_until = NULL, "
+        "last_error = NULL, updated_at = CURRENT_TIMESTAMP "
+        "WHERE id = ANY($1::bigint[]) AND worker = $2",
+        to_pg_array(ids), worker);
+    return {};
+  } catch (const std::exception &e) {
+    return std::unexpected(e.what());
+  }
+}
+
+std::expected<void, std::string>
+PostgresImportJobRepository::fail(const std::string &worker, std::int64_t id,
+                                  const std::string &error) {
+  auto db = drogon::app().getDbClient();
+  try {
+    db->execSqlSync(
+        "UPDATE import_jobs SET "
+        "status = CASE WHEN attempts >= max_attempts THEN 'failed' "
+        "ELSE 'pending' END, "
+        "lease_until = NULL, last_error = $3, updated_at = CURRENT_TIMESTAMP "
+        "WHERE id = $1::bigint AND worker = $2",
+        std::to_string(id), worker, error);
+    return {};
+  } catch (const std::exception &e) {
+    return std::unexpected(e.what());
+  }
+}
+
+std::expected<std::size_t, std::string>
+PostgresImportJobRepository::expire_exhausted() {
+  auto db = drogon::app().getDbClient();
+  try {
+    auto result = db->execSqlSync(
+        "UPDATE import_jobs SET status = 'failed', "
+        "last_error = COALESCE(last_error, 'lease expired'), "
+        "updated_at = CURRENT_TIMESTAMP "
+        "WHERE status = 'running' AND lease_until < CURRENT_TIMESTAMP "
+        "AND attempts >= max_attempts");
+    return static_cast<std::size_t>(result.affectedRows());
+  } catch (const std::exception &e) {
+    return std::unexpected(e.what());
+  }
+}
+
+std::expected<ImportJobCounts, std::string>
+PostgresImportJobRepository::counts() {
+  auto db = drogon::app().getDbClient();
+  try {
+    auto result = db->execSqlSync(
+        "SELECT status, count(*) AS n FROM import_jobs GROUP BY status");
+    ImportJobCounts counts;
+    for (const auto &row : result) {
+      auto status = row["status"].template as<std::string>();
+      auto n = static_cast<std::size_t>(row["n"].template as<int64_t>());
+      if (status == "pending")
+        counts.pending = n;
+      else if (status == "running")
+        counts.running = n;
+      else if (status == "done")
+        counts.done = n;
+      else if (status == "failed")
+        counts.failed = n;
+    }
+    return counts;
+  } catch (const std::exception &e) {
+    return std::unexpected(e.what());
+  }
+}
+
+} // namespace infra::repositories
@@ -0,0 +1,54 @@
+/**
+ * SPDX-FileComment: Import Job Queue Repository Header
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file import_job_repository.hpp
+ * @brief PostgreSQL Implementation of the Import Job Queue Repository
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include "domain/interfaces/i_import_job_repository.hpp"
+#include <drogon/orm/DbClient.h>
+
+namespace infra::repositories {
+
+using namespace domain::models;
+using namespace domain::interfaces;
+
+/**
+ * @class PostgresImportJobRepository
+ * @brief import_jobs table claimed with FOR UPDATE SKIP LOCKED.
+ */
+class PostgresImportJobRepository : public IImportJobRepository {
+public:
+  std::expected<std::size_t, std::string>
+  enqueue(const std::string &base_path,
+          const std::vector<std::string> &file_paths) override;
+  std::expected<std::vector<ImportJob>, std::string>
+  claim(const std::string &worker, std::size_t limit,
+        std::chrono::seconds lease) override;
+  std::expected<void, std::string>
+  renew(const std::string &worker, const std::vector<std::int64_t> &ids,
+        std::chrono::seconds lease) override;
+  std::expected<void, std::string>
+  complete(const std::string &worker,
+           const std::vector<std::int64_t> &ids) override;
+  std::expected<void, std::string> fail(const std::string &worker,
+                                        std::int64_t id,
+                                        const std::string &error) override;
+  std::expected<std::size_t, std::string> expire_exhausted() override;
+  std::expected<ImportJobCounts, std::string> counts() override;
+};
+
+} // namespace infra::repositories
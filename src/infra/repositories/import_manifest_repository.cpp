@@ -0,0 +1,74 @@
+/**
+ * SPDX-FileComment: Import Manifest Repository Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file import_manifest_repository.cpp
+ * @brief PostgreSQL Implementation of the Import Manifest Repository
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "import_manifest_repository.hpp"
+#include <drogon/drogon.h>
+
+namespace infra::repositories {
+
+std::expected<std::vector<ManifestEntry>, std::string>
+PostgresImportManifestRepository::find_all() {
+  auto db = drogon::app().getDbClient();
+  try {
+    auto result = db->execSqlSync(
+        "SELECT file_path, file_size, mtime_ns, inode, content_hash, photo_id "
+        "FROM import_manifest");
+    std::vector<ManifestEntry> entries;
+    entries.reserve(result.size());
+    for (const auto &row : result) {
+      ManifestEntry e;
+      e.file_path = row["file_path"].template as<std::string>();
+      e.file_size = row["file_size"].template as<int64_t>();
+      e.mtime_ns = row["mtime_ns"].template as<int64_t>();
+      e.inode = row["inode"].template as<int64_t>();
+      e.content_hash = row["content_hash"].template as<std::string>();
+      if (!row["photo_id"].isNull())
+        e.photo_id = row["photo_id"].template as<std::string>();
+      entries.push_back(std::move(e));
+    }
+    return entries;
+  } catch (const std::exception &e) {
+    return std::unexpected(e.what());
+  }
+}
+
+std::expected<void, std::string>
+PostgresImportManifestRepository::upsert(const ManifestEntry &entry) {
+  auto db = drogon::app().getDbClient();
+  try {
+    db->execSqlSync(
+        "INSERT INTO import_manifest (file_path, file_size, mtime_ns, inode, "
+        "content_hash, photo_id) "
+        "VALUES ($1, $2::bigint, $3::bigint, $4::bigint, $5, $6::uuid) "
+        "ON CONFLICT (file_path) DO UPDATE SET file_size = EXCLUDED.file_size, "
+        "mtime_ns = EXCLUDED.mtime_ns, inode = EXCLUDED.inode, "
+        "content_hash = EXCLUDED.content_hash, "
+        "photo_id = COALESCE(EXCLUDED.photo_id, import_manifest.photo_id), "
+        "updated_at = CURRENT_TIMESTAMP",
+        entry.file_path, std::to_string(entry.file_size),
+        std::to_string(entry.mtime_ns), std::to_string(entry.inode),
+        entry.content_hash,
+        entry.photo_id ? Json::Value(*entry.photo_id)
+                       : Json::Value(Json::nullValue));
+    return {};
+  } catch (const std::exception &e) {
+    return std::unexpected(e.what());
+  }
+}
+
+} // namespace infra::repositories
@@ -0,0 +1,44 @@
+/**
+ * SPDX-FileComment: Import Manifest Repository Header
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file import_manifest_repository.hpp
+ * @brief PostgreSQL Implementation of the Import Manifest Repository
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include "domain/interfaces/i_import_manifest_repository.hpp"
+#include <drogon/orm/DbClient.h>
+
+/**
+ * @namespace infra::repositories
+ * @brief Namespace for infrastructure data access repositories.
+ */
+namespace infra::repositories {
+
+using namespace domain::models;
+using namespace domain::interfaces;
+
+/**
+ * @class PostgresImportManifestRepository
+ * @brief PostgreSQL implementation of IImportManifestRepository.
+ */
+class PostgresImportManifestRepository : public IImportManifestRepository {
+public:
+  std::expected<std::vector<ManifestEntry>, std::string> find_all() override;
+  std::expected<void, std::string>
+  upsert(const ManifestEntry &entry) override;
+};
+
+} // namespace infra::repositories
@@ -7,8 +7,8 @@
  *
  * @file photo_repository.cpp
  * @brief PostgreSQL Implementation of Photo Repository
- * @version 0.1.12
- * @date 2026-02-25
+ * @version 0.1.13
+ * @date 2026-10-17
  *
  * @author ZHENG Robert (robert@hase-zheng.net)
  * @copyright Copyright (c) 2026 ZHENG Robert
@@ -17,11 +17,29 @@
  */
 
 #include "photo_repository.hpp"
+#include "infra/util/pg_array.hpp"
 #include <drogon/drogon.h>
+#include <future>
 #include <json/json.h>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
 
 namespace infra::repositories {
 
+using infra::util::to_pg_array;
+
+// Follows a "WITH removed AS (DELETE FROM photos ... RETURNING file_path,
+// thumb_path)". thumbnail_packs has no foreign key because duplicates share
+// thumbnails, so a thumbnail's pack rows go once no remaining photo uses
+// it. The statement still sees the deleted photos, hence the NOT IN.
+static constexpr std::string_view kDropUnusedPacks =
+    ", unpacked AS (DELETE FROM thumbnail_packs t USING removed r "
+    "WHERE t.thumb_path = r.thumb_path AND NOT EXISTS ("
+    "SELECT 1 FROM photos p WHERE p.thumb_path = r.thumb_path "
+    "AND p.file_path NOT IN (SELECT file_path FROM removed))) "
+    "SELECT count(*) AS removed FROM removed";
+
 static std::vector<Photo> map_photo_result(const drogon::orm::Result &result) {
   std::vector<Photo> photos;
   for (const auto &row : result) {
@@ -37,6 +55,8 @@ static std::vector<Photo> map_photo_result(const drogon::orm::Result &result) {
     if (!row["gps_lat"].isNull()) p.gps_lat = row["gps_lat"].template as<double>();
     if (!row["gps_lon"].isNull()) p.gps_lon = row["gps_lon"].template as<double>();
     if (!row["gps_alt"].isNull()) p.gps_alt = row["gps_alt"].template as<double>();
+    if (!row["blurhash"].isNull()) p.blurhash = row["blurhash"].template as<std::string>();
+    if (!row["dominant_color"].isNull()) p.dominant_color = row["dominant_color"].template as<std::string>();
     p.is_public = row["is_public"].template as<bool>();
     photos.push_back(p);
   }
@@ -55,7 +75,8 @@ PostgresPhotoRepository::find_all(const PhotoFilter &filter) {
   auto db = drogon::app().getDbClient();
   try {
     std::string sql = "SELECT id, file_name, file_path, thumb_path, width, "
-                      "height, camera_make, camera_model, gps_lat, gps_lon, gps_alt, is_public FROM photos";
+                      "height, camera_make, camera_model, gps_lat, gps_lon, gps_alt, "
+                      "blurhash, dominant_color, is_public FROM photos";
 
     // Use strings for pagination to avoid protocol mismatches
     std::string limit_str = std::to_string(filter.limit);
@@ -107,6 +128,8 @@ PostgresPhotoRepository::find_by_id(std::string_view id) {
     if (!row["gps_lat"].isNull()) p.gps_lat = row["gps_lat"].template as<double>();
     if (!row["gps_lon"].isNull()) p.gps_lon = row["gps_lon"].template as<double>();
     if (!row["gps_alt"].isNull()) p.gps_alt = row["gps_alt"].template as<double>();
+    if (!row["blurhash"].isNull()) p.blurhash = row["blurhash"].template as<std::string>();
+    if (!row["dominant_color"].isNull()) p.dominant_color = row["dominant_color"].template as<std::string>();
     p.is_public = row["is_public"].template as<bool>();
     return p;
   } catch (const std::exception &e) {
@@ -114,16 +137,24 @@ PostgresPhotoRepository::find_by_id(std::string_view id) {
   }
 }
 
-std::expected<void, std::string>
-PostgresPhotoRepository::save(const Photo &photo) {
-  auto db = drogon::app().getDbClient();
-  try {
-    db->execSqlSync("INSERT INTO photos (id, location_id, file_name, file_path, thumb_path, "
-                    "width, height, camera_make, camera_model, gps_lat, gps_lon, gps_alt, is_public) "
-                    "VALUES ($1::uuid, $2::uuid, $3, $4, $5, $6::int, $7::int, $8, $9, $10::double precision, $11::double precision, $12::double precision, $13::boolean) "
+// Inserts or updates one photo row (keyed by file_path) and returns its id.
+// Duplicates render no thumbnails and carry no placeholder of their own;
+// they take the one stored for the same content hash.
+static std::string upsert_photo(drogon::orm::DbClient &db, const Photo &photo) {
+  auto result = db.execSqlSync("INSERT INTO photos (id, location_id, file_name, file_path, thumb_path, "
+                    "width, height, camera_make, camera_model, gps_lat, gps_lon, gps_alt, is_public, content_hash, "
+                    "blurhash, dominant_color) "
+                    "VALUES ($1::uuid, $2::uuid, $3, $4, $5, $6::int, $7::int, $8, $9, $10::double precision, $11::double precision, $12::double precision, $13::boolean, $14, "
+                    "COALESCE($15::text, (SELECT blurhash FROM photos WHERE content_hash = $14 AND blurhash IS NOT NULL LIMIT 1)), "
+                    "COALESCE($16::text, (SELECT dominant_color FROM photos WHERE content_hash = $14 AND dominant_color IS NOT NULL LIMIT 1))) "
                     "ON CONFLICT (file_path) DO UPDATE SET thumb_path = "
                     "EXCLUDED.thumb_path, is_public = EXCLUDED.is_public, "
-                    "gps_lat = EXCLUDED.gps_lat, gps_lon = EXCLUDED.gps_lon, gps_alt = EXCLUDED.gps_alt",
+                    "location_id = EXCLUDED.location_id, width = EXCLUDED.width, height = EXCLUDED.height, "
+                    "camera_make = EXCLUDED.camera_make, camera_model = EXCLUDED.camera_model, "
+                    "gps_lat = EXCLUDED.gps_lat, gps_lon = EXCLUDED.gps_lon, gps_alt = EXCLUDED.gps_alt, "
+                    "content_hash = EXCLUDED.content_hash, blurhash = EXCLUDED.blurhash, "
+                    "dominant_color = EXCLUDED.dominant_color "
+                    "RETURNING id",
                     photo.id, 
                     to_json_param(photo.location_id), 
                     photo.file_name, 
@@ -136,8 +167,248 @@ PostgresPhotoRepository::save(const Photo &photo) {
                     to_json_param(photo.gps_lat), 
                     to_json_param(photo.gps_lon), 
                     to_json_param(photo.gps_alt), 
-                    photo.is_public);
-    return {};
+                    photo.is_public,
+                    to_json_param(photo.content_hash),
+                    to_json_param(photo.blurhash),
+                    to_json_param(photo.dominant_color));
+  return result[0]["id"].template as<std::string>();
+}
+
+// Replaces the key/value rows of one metadata table for all given photos
+// with a single DELETE and a single unnest() INSERT.
+static void replace_metadata(drogon::orm::DbClient &db, const std::string &table,
+                             const std::vector<std::string> &photo_ids,
+                             const std::vector<std::string> &row_ids,
+                             const std::vector<std::string> &keys,
+                             const std::vector<std::string> &values) {
+  db.execSqlSync("DELETE FROM " + table + " WHERE photo_id = ANY($1::uuid[])",
+                 to_pg_array(photo_ids));
+  if (keys.empty()) return;
+  db.execSqlSync("INSERT INTO " + table + " (photo_id, key, value) "
+                 "SELECT * FROM unnest($1::uuid[], $2::text[], $3::text[])",
+                 to_pg_array(row_ids), to_pg_array(keys), to_pg_array(values));
+}
+
+// Writes the metadata maps and tags of photos[i] under ids[i]. Metadata rows
+// are always replaced; existing tags are only dropped with replace_tags.
+static void write_metadata(drogon::orm::DbClient &db,
+                           const std::vector<Photo> &photos,
+                           const std::vector<std::string> &ids,
+                           bool replace_tags) {
+  auto collect = [&](auto member, const std::string &table) {
+    std::vector<std::string> row_ids, keys, values;
+    for (std::size_t i = 0; i < photos.size(); ++i) {
+      for (const auto &[key, value] : photos[i].*member) {
+        row_ids.push_back(ids[i]);
+        keys.push_back(key);
+        values.push_back(value);
+      }
+    }
+    replace_metadata(db, table, ids, row_ids, keys, values);
+  };
+  collect(&Photo::exif, "photo_metadata_exif");
+  collect(&Photo::iptc, "photo_metadata_iptc");
+  collect(&Photo::xmp, "photo_metadata_xmp");
+
+  if (replace_tags)
+    db.execSqlSync("DELETE FROM photo_tags WHERE photo_id = ANY($1::uuid[])",
+                   to_pg_array(ids));
+  std::vector<std::string> tag_ids, tags;
+  for (std::size_t i = 0; i < photos.size(); ++i) {
+    for (const auto &tag : photos[i].tags) {
+      tag_ids.push_back(ids[i]);
+      tags.push_back(tag);
+    }
+  }
+  if (!tags.empty()) {
+    db.execSqlSync("INSERT INTO photo_tags (photo_id, tag) "
+                   "SELECT * FROM unnest($1::uuid[], $2::text[]) "
+                   "ON CONFLICT DO NOTHING",
+                   to_pg_array(tag_ids), to_pg_array(tags));
+  }
+}
+
+std::expected<std::string, std::string>
+PostgresPhotoRepository::save(const Photo &photo) {
+  auto db = drogon::app().getDbClient();
+  try {
+    return upsert_photo(*db, photo);
+  } catch (const std::exception &e) {
+    return std::unexpected(e.what());
+  }
+}
+
+std::expected<std::vector<std::string>, std::string>
+PostgresPhotoRepository::save_batch(const std::vector<Photo> &photos) {
+  if (photos.empty()) return std::vector<std::string>{};
+
+  auto db = drogon::app().getDbClient();
+  auto committed = std::make_shared<std::promise<bool>>();
+  auto commit_result = committed->get_future();
+  std::vector<std::string> ids;
+  ids.reserve(photos.size());
+
+  try {
+    auto tx = db->newTransaction(
+        [committed](bool success) { committed->set_value(success); });
+    try {
+      for (const auto &photo : photos) {
+        ids.push_back(upsert_photo(*tx, photo));
+      }
+
+      write_metadata(*tx, photos, ids, false);
+    } catch (...) {
+      tx->rollback();
+      throw;
+    }
+    // Releasing the last reference commits; the callback reports the result.
+  } catch (const std::exception &e) {
+    return std::unexpected(e.what());
+  }
+
+  if (!commit_result.get()) return std::unexpected("Commit failed");
+  return ids;
+}
+
+std::expected<void, std::string>
+PostgresPhotoRepository::replace_metadata_batch(const std::vector<Photo> &photos) {
+  if (photos.empty()) return {};
+
+  auto db = drogon::app().getDbClient();
+  auto committed = std::make_shared<std::promise<bool>>();
+  auto commit_result = committed->get_future();
+
+  try {
+    auto tx = db->newTransaction(
+        [committed](bool success) { committed->set_value(success); });
+    try {
+      std::vector<std::string> paths;
+      paths.reserve(photos.size());
+      for (const auto &photo : photos)
+        paths.push_back(photo.file_path);
+      auto result = tx->execSqlSync(
+          "SELECT id, file_path FROM photos WHERE file_path = ANY($1::text[])",
+          to_pg_array(paths));
+      std::unordered_map<std::string, std::string> id_of;
+      for (const auto &row : result)
+        id_of.emplace(row["file_path"].template as<std::string>(),
+                      row["id"].template as<std::string>());
+
+      std::vector<std::string> ids;
+      ids.reserve(photos.size());
+      for (const auto &photo : photos) {
+        auto it = id_of.find(photo.file_path);
+        if (it == id_of.end())
+          throw std::runtime_error("No photo stored for " + photo.file_path);
+        ids.push_back(it->second);
+      }
+      write_metadata(*tx, photos, ids, true);
+    } catch (...) {
+      tx->rollback();
+      throw;
+    }
+  } catch (const std::exception &e) {
+    return std::unexpected(e.what());
+  }
+
+  if (!commit_result.get()) return std::unexpected("Commit failed");
+  return {};
+}
+
+std::expected<std::optional<Photo>, std::string>
+PostgresPhotoRepository::find_by_content_hash(std::string_view content_hash) {
+  auto db = drogon::app().getDbClient();
+  try {
+    auto result = db->execSqlSync(
+        "SELECT id, file_name, file_path, thumb_path, width, height, "
+        "camera_make, camera_model, gps_lat, gps_lon, gps_alt, blurhash, "
+        "dominant_color, is_public FROM photos WHERE content_hash = $1 AND thumb_path IS NOT NULL "
+        "ORDER BY created_at LIMIT 1",
+        std::string(content_hash));
+    auto photos = map_photo_result(result);
+    if (photos.empty())
+      return std::nullopt;
+    return photos.front();
+  } catch (const std::exception &e) {
+    return std::unexpected(e.what());
+  }
+}
+
+std::expected<std::vector<DuplicateGroup>, std::string>
+PostgresPhotoRepository::find_duplicates() {
+  auto db = drogon::app().getDbClient();
+  try {
+    auto result = db->execSqlSync(
+        "SELECT content_hash, file_path FROM photos "
+        "WHERE content_hash IN (SELECT content_hash FROM photos "
+        "WHERE content_hash IS NOT NULL GROUP BY content_hash "
+        "HAVING count(*) > 1) "
+        "ORDER BY content_hash, file_path");
+    std::vector<DuplicateGroup> groups;
+    for (const auto &row : result) {
+      auto hash = row["content_hash"].template as<std::string>();
+      if (groups.empty() || groups.back().content_hash != hash)
+        groups.push_back({hash, {}});
+      groups.back().file_paths.push_back(
+          row["file_path"].template as<std::string>());
+    }
+    return groups;
+  } catch (const std::exception &e) {
+    return std::unexpected(e.what());
+  }
+}
+
+std::expected<std::size_t, std::string>
+PostgresPhotoRepository::remove_by_path(std::string_view path) {
+  auto db = drogon::app().getDbClient();
+  try {
+    // Metadata, tags and manifest rows follow via ON DELETE CASCADE.
+    auto result = db->execSqlSync(
+        "WITH removed AS (DELETE FROM photos "
+        "WHERE file_path = $1 OR starts_with(file_path, $2) "
+        "RETURNING file_path, thumb_path)" +
+            std::string(kDropUnusedPacks),
+        std::string(path), std::string(path) + "/");
+    return static_cast<std::size_t>(
+        result[0]["removed"].template as<std::int64_t>());
+  } catch (const std::exception &e) {
+    return std::unexpected(e.what());
+  }
+}
+
+std::expected<std::vector<PhotoPaths>, std::string>
+PostgresPhotoRepository::list_paths() {
+  auto db = drogon::app().getDbClient();
+  try {
+    auto result = db->execSqlSync("SELECT file_path, thumb_path FROM photos");
+    std::vector<PhotoPaths> paths;
+    paths.reserve(result.size());
+    for (const auto &row : result) {
+      PhotoPaths p;
+      p.file_path = row["file_path"].template as<std::string>();
+      if (!row["thumb_path"].isNull())
+        p.thumb_path = row["thumb_path"].template as<std::string>();
+      paths.push_back(std::move(p));
+    }
+    return paths;
+  } catch (const std::exception &e) {
+    return std::unexpected(e.what());
+  }
+}
+
+std::expected<std::size_t, std::string>
+PostgresPhotoRepository::remove_paths(const std::vector<std::string> &file_paths) {
+  if (file_paths.empty()) return 0;
+  auto db = drogon::app().getDbClient();
+  try {
+    auto result = db->execSqlSync(
+        "WITH removed AS (DELETE FROM photos "
+        "WHERE file_path = ANY($1::text[]) "
+        "RETURNING file_path, thumb_path)" +
+            std::string(kDropUnusedPacks),
+        to_pg_array(file_paths));
+    return static_cast<std::size_t>(
+        result[0]["removed"].template as<std::int64_t>());
   } catch (const std::exception &e) {
     return std::unexpected(e.what());
   }
@@ -234,6 +505,29 @@ PostgresLocationRepository::get_tree(bool only_public) {
   }
 }
 
+std::expected<std::vector<Location>, std::string>
+PostgresLocationRepository::find_all() {
+  auto db = drogon::app().getDbClient();
+  try {
+    auto result = db->execSqlSync(
+        "SELECT id, continent, country, province, city FROM locations");
+    std::vector<Location> locs;
+    locs.reserve(result.size());
+    for (const auto &row : result) {
+      Location l;
+      l.id = row["id"].template as<std::string>();
+      l.continent = row["continent"].template as<std::string>();
+      l.country = row["country"].template as<std::string>();
+      l.province = row["province"].template as<std::string>();
+      l.city = row["city"].template as<std::string>();
+      locs.push_back(l);
+    }
+    return locs;
+  } catch (const std::exception &e) {
+    return std::unexpected(e.what());
+  }
+}
+
 std::expected<std::optional<Location>, std::string>
 PostgresLocationRepository::find_or_create(const Location &loc) {
   auto db = drogon::app().getDbClient();
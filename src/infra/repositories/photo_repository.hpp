@@ -7,8 +7,8 @@
  *
  * @file photo_repository.hpp
  * @brief PostgreSQL Implementation of Photo and Location Repositories
- * @version 0.1.0
- * @date 2026-02-24
+ * @version 0.1.1
+ * @date 2026-10-17
  *
  * @author ZHENG Robert (robert@hase-zheng.net)
  * @copyright Copyright (c) 2026 ZHENG Robert
@@ -40,7 +40,20 @@ public:
   find_all(const PhotoFilter &filter) override;
   std::expected<std::optional<Photo>, std::string>
   find_by_id(std::string_view id) override;
-  std::expected<void, std::string> save(const Photo &photo) override;
+  std::expected<std::string, std::string> save(const Photo &photo) override;
+  std::expected<std::vector<std::string>, std::string>
+  save_batch(const std::vector<Photo> &photos) override;
+  std::expected<void, std::string>
+  replace_metadata_batch(const std::vector<Photo> &photos) override;
+  std::expected<std::optional<Photo>, std::string>
+  find_by_content_hash(std::string_view content_hash) override;
+  std::expected<std::vector<DuplicateGroup>, std::string>
+  find_duplicates() override;
+  std::expected<std::size_t, std::string>
+  remove_by_path(std::string_view path) override;
+  std::expected<std::vector<PhotoPaths>, std::string> list_paths() override;
+  std::expected<std::size_t, std::string>
+  remove_paths(const std::vector<std::string> &file_paths) override;
   std::expected<void, std::string> add_tag(std::string_view photo_id,
                                            std::string_view tag) override;
   std::expected<void, std::string> save_metadata_exif(std::string_view photo_id, const std::map<std::string, std::string>& metadata) override;
@@ -56,6 +69,7 @@ class PostgresLocationRepository : public ILocationRepository {
 public:
   std::expected<std::vector<Location>, std::string>
   get_tree(bool only_public = false) override;
+  std::expected<std::vector<Location>, std::string> find_all() override;
   std::expected<std::optional<Location>, std::string>
   find_or_create(const Location &loc) override;
 };
@@ -0,0 +1,116 @@
+/**
+ * SPDX-FileComment: Thumbnail Pack Index Repository Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file thumbnail_pack_repository.cpp
+ * @brief PostgreSQL Implementation of the Thumbnail Pack Index Repository
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#include "thumbnail_pack_repository.hpp"
+#include "infra/util/pg_array.hpp"
+#include <drogon/drogon.h>
+
+namespace infra::repositories {
+
+using infra::util::to_pg_array;
+
+std::expected<void, std::string> PostgresThumbnailPackRepository::record(
+    const std::vector<PackedThumbnail> &thumbnails) {
+  if (thumbnails.empty())
+    return {};
+  std::vector<std::string> thumb_paths;
+  std::vector<std::int64_t> sizes;
+  std::vector<std::string> packs;
+  std::vector<std::int64_t> offsets;
+  std::vector<std::int64_t> lengths;
+  for (const auto &t : thumbnails) {
+    thumb_paths.push_back(t.thumb_path);
+    sizes.push_back(t.size);
+    packs.push_back(t.pack);
+    offsets.push_back(t.offset);
+    lengths.push_back(t.length);
+  }
+
+  auto db = drogon::app().getDbClient();
+  try {
+    db->execSqlSync(
+        "INSERT INTO thumbnail_packs "
+        "(thumb_path, size, pack, pack_offset, length) "
+        "SELECT * FROM unnest($1::text[], $2::int[], $3::text[], "
+        "$4::bigint[], $5::bigint[]) "
+        "ON CONFLICT (thumb_path, size) DO UPDATE SET pack = EXCLUDED.pack, "
+        "pack_offset = EXCLUDED.pack_offset, length = EXCLUDED.length",
+        to_pg_array(thumb_paths), to_pg_array(sizes), to_pg_array(packs),
+        to_pg_array(offsets), to_pg_array(lengths));
+    return {};
+  } catch (const std::exception &e) {
+    return std::unexpected(e.what());
+  }
+}
+
+std::expected<std::optional<PackedThumbnail>, std::string>
+PostgresThumbnailPackRepository::find(const std::string &thumb_path,
+                                      int size) {
+  auto db = drogon::app().getDbClient();
+  try {
+    auto result = db->execSqlSync(
+        "SELECT pack, pack_offset, length FROM thumbnail_packs "
+        "WHERE thumb_path = $1 AND size = $2::int",
+        thumb_path, std::to_string(size));
+    if (result.empty())
+      return std::nullopt;
+    PackedThumbnail t;
+    t.thumb_path = thumb_path;
+    t.size = size;
+    t.pack = result[0]["pack"].template as<std::string>();
+    t.offset = result[0]["pack_offset"].template as<int64_t>();
+    t.length = result[0]["length"].template as<int64_t>();
+    return t;
+  } catch (const std::exception &e) {
+    return std::unexpected(e.what());
+  }
+}
+
+std::expected<std::vector<std::string>, std::string>
+PostgresThumbnailPackRepository::list(int size) {
+  auto db = drogon::app().getDbClient();
+  try {
+    auto result = db->execSqlSync(
+        "SELECT thumb_path FROM thumbnail_packs WHERE size = $1::int",
+        std::to_string(size));
+    std::vector<std::string> paths;
+    paths.reserve(result.size());
+    for (const auto &row : result)
+      paths.push_back(row["thumb_path"].template as<std::string>());
+    return paths;
+  } catch (const std::exception &e) {
+    return std::unexpected(e.what());
+  }
+}
+
+std::expected<void, std::string> PostgresThumbnailPackRepository::remove(
+    int size, const std::vector<std::string> &thumb_paths) {
+  if (thumb_paths.empty())
+    return {};
+  auto db = drogon::app().getDbClient();
+  try {
+    db->execSqlSync("DELETE FROM thumbnail_packs "
+                    "WHERE size = $1::int AND thumb_path = ANY($2::text[])",
+                    std::to_string(size), to_pg_array(thumb_paths));
+    return {};
+  } catch (const std::exception &e) {
+    return std::unexpected(e.what());
+  }
+}
+
+} // namespace infra::repositories
@@ -0,0 +1,45 @@
+/**
+ * SPDX-FileComment: Thumbnail Pack Index Repository Header
+ * SPDX-FileType: HEADER
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * @file thumbnail_pack_repository.hpp
+ * @brief PostgreSQL Implementation of the Thumbnail Pack Index Repository
+ * @version 0.1.0
+ * @date 2026-10-17
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license Apache-2.0
+ */
+
+#pragma once
+
+#include "domain/interfaces/i_thumbnail_pack_repository.hpp"
+#include <drogon/orm/DbClient.h>
+
+namespace infra::repositories {
+
+using namespace domain::models;
+using namespace domain::interfaces;
+
+/**
+ * @class PostgresThumbnailPackRepository
+ * @brief thumbnail_packs table, one row per photo and size.
+ */
+class PostgresThumbnailPackRepository : public IThumbnailPackRepository {
+public:
+  std::expected<void, std::string>
+  record(const std::vector<PackedThumbnail> &thumbnails) override;
+  std::expected<std::optional<PackedThumbnail>, std::string>
+  find(const std::string &thumb_path, int size) override;
+  std::expected<std::vector<std::string>, std::string>
+  list(int size) override;
+  std::expected<void, std::string>
+  remove(int size, const std::vector<std::string> &thumb_paths) override;
+};
+
+} // namespace infra::repositories